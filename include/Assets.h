@@ -2,8 +2,11 @@
 
 #include <unordered_map>
 #include <string>
+#include <vector>
+#include <memory>
 
 #include "raylib-cpp.hpp"
+#include "Core/PieceSet.h"
 
 void LoadAssets();
 
@@ -15,4 +18,7 @@ raylib::Sound& GetSound(std::string name);
 
 raylib::Music& GetMusic(std::string name);
 
-raylib::Font& GetFont(std::string name);
\ No newline at end of file
+raylib::Font& GetFont(std::string name);
+
+/// Standard piece set first, then every valid set in assets/pieces
+const std::vector<std::shared_ptr<const PieceSet>>& GetPieceSets();
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Core/BlockColor.h"
+
+enum BlockCellState : unsigned char
+{
+	BLOCK_EMPTY, //No block
+	BLOCK_CLEARING, //Clearing this block, for line clear animation
+	BLOCK_GRID //A non-empty block, placed or moving
+};
+
+//One byte per cell: the state and an index into BLOCK_PALETTE
+struct BlockCell
+{
+	BlockCellState state : 2;
+	unsigned char colorIndex : 6;
+
+	BlockCell()
+	{
+		state = BLOCK_EMPTY;
+		colorIndex = PALETTE_BLANK;
+	}
+
+	BlockCell(BlockCellState state, unsigned char colorIndex)
+	{
+		this->state = state;
+		this->colorIndex = colorIndex;
+	}
+};
+
+static_assert(sizeof(BlockCell) == 1, "Board cells are packed into a single byte");
\ No newline at end of file
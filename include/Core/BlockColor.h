@@ -0,0 +1,62 @@
+#pragma once
+
+//RGBA color of a block, kept separate from raylib so the simulation core can run without it
+struct BlockColor
+{
+	unsigned char r;
+	unsigned char g;
+	unsigned char b;
+	unsigned char a;
+
+	constexpr BlockColor(unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+	{
+		this->r = r;
+		this->g = g;
+		this->b = b;
+		this->a = a;
+	}
+
+	constexpr BlockColor()
+	{
+		r = 0;
+		g = 0;
+		b = 0;
+		a = 0;
+	}
+
+	//Same values as the raylib colors of the same name
+	static constexpr BlockColor Blank() { return BlockColor(0, 0, 0, 0); }
+	static constexpr BlockColor Yellow() { return BlockColor(253, 249, 0, 255); }
+	static constexpr BlockColor SkyBlue() { return BlockColor(102, 191, 255, 255); }
+	static constexpr BlockColor Red() { return BlockColor(230, 41, 55, 255); }
+	static constexpr BlockColor Green() { return BlockColor(0, 228, 48, 255); }
+	static constexpr BlockColor Orange() { return BlockColor(255, 161, 0, 255); }
+	static constexpr BlockColor Pink() { return BlockColor(255, 109, 194, 255); }
+	static constexpr BlockColor Purple() { return BlockColor(200, 122, 255, 255); }
+};
+
+//Indices into BLOCK_PALETTE, so pieces and cells only need a byte for their color
+enum BlockPaletteIndex
+{
+	PALETTE_BLANK = 0,
+	PALETTE_YELLOW = 1,
+	PALETTE_SKY_BLUE = 2,
+	PALETTE_RED = 3,
+	PALETTE_GREEN = 4,
+	PALETTE_ORANGE = 5,
+	PALETTE_PINK = 6,
+	PALETTE_PURPLE = 7,
+	NUM_PALETTE_COLORS = 8
+};
+
+inline constexpr BlockColor BLOCK_PALETTE[NUM_PALETTE_COLORS] =
+{
+	BlockColor::Blank(),
+	BlockColor::Yellow(),
+	BlockColor::SkyBlue(),
+	BlockColor::Red(),
+	BlockColor::Green(),
+	BlockColor::Orange(),
+	BlockColor::Pink(),
+	BlockColor::Purple()
+};
\ No newline at end of file
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+
+#include "Vector2Int.h"
+#include "Core/BlockCell.h"
+#include "Core/Piece.h"
+#include "Core/PieceMask.h"
+#include "Core/Snapshot.h"
+#include "Core/Zobrist.h"
+
+//Grid sizes with collision queries specialized at compile time, any other size uses the runtime sized queries
+enum BoardSizeClass
+{
+	BOARD_SIZE_CUSTOM,
+	BOARD_SIZE_10X20,
+	BOARD_SIZE_10X40
+};
+
+//Cells outside the grid that can still be read, each side of the grid has this many guard columns or lines
+const int BOARD_GUARD_SIZE = MAX_PIECE_BLOCKS;
+
+//Columns of walls the grid is padded with when testing kicks, pieces are never further outside of the grid than this
+const int BOARD_KICK_PADDING = 16;
+
+//Most lines read at once when testing kicks, offsets spanning more lines are tested one by one
+const int BOARD_MAX_KICK_LINES = PIECE_MASK_MAX_ROWS * 3;
+
+//Most storage rows allocated at once, tall grids only allocate the chunks that blocks are placed in
+const int BOARD_MAX_CHUNK_ROWS = 64;
+
+//Grid of block cells, with a bit mask per row mirroring which cells are not empty. Boards can be at most 31 cells wide.
+//Lines are reached through a row table, so clearing lines and inserting garbage lines move row indices instead of cells.
+//The grid is surrounded by a guard band: empty lines above it, walls to its sides and below it.
+//The top of each column is kept up to date as well, for quick drop distances and stack height queries.
+//So is a Zobrist hash of the cells: a cell change rehashes its line and moving lines rehashes the lines of the stack, never the whole grid.
+class Board
+{
+	private:
+		Vector2Int size = Vector2Int{ 0, 0 };
+
+		//storage rows 0 to size.y - 1 hold the grid, after them come an empty ceiling row and a wall floor row for the guard lines
+		//storage rows are allocated in chunks of 1 << chunkRowsShift rows, each row is preceded by BOARD_GUARD_SIZE wall cells and the last one is followed by them too
+		//chunks that have never been written to all point to the same empty chunk
+		BlockCell** cellChunks = nullptr;
+		BlockCell* emptyChunk = nullptr;
+		int numChunks = 0;
+		int chunkCapacity = 0;
+		int chunkRowsShift = 0;
+		int chunkNumCells = 0;
+		int rowStride = 0;
+
+		//bit x is set if cell x of the storage row is not empty
+		uint32_t* rowMasks = nullptr;
+		uint32_t fullRowMask = 0;
+
+		//xor of the keys of the cells in each storage row, 0 for empty rows
+		uint64_t* rowHashes = nullptr;
+		//xor of the line hashes
+		uint64_t hash = 0;
+
+		//storage row of each line, with BOARD_GUARD_SIZE guard lines on both ends
+		int* rowTable = nullptr;
+		int rowCapacity = 0;
+
+		//y of the highest non-empty cell in each column, size.y if the column is empty
+		int* columnTops = nullptr;
+		int columnCapacity = 0;
+
+		void DeleteGrid();
+
+		inline int GetStorageRow(int y) const
+		{
+			return rowTable[BOARD_GUARD_SIZE + y];
+		}
+
+		//first cell of the storage row, cells up to BOARD_GUARD_SIZE to either side can be read as well
+		inline const BlockCell* GetStorageRowCells(int storageRow) const
+		{
+			return cellChunks[storageRow >> chunkRowsShift] + BOARD_GUARD_SIZE + (storageRow & ((1 << chunkRowsShift) - 1)) * rowStride;
+		}
+
+		BlockCell* GetWritableStorageRowCells(int storageRow);
+
+		//selects the collision queries specialized for the grid size
+		BoardSizeClass sizeClass = BOARD_SIZE_CUSTOM;
+
+		void ClearStorageRow(int storageRow);
+		int FindColumnTop(int x, int fromY) const;
+
+		static uint64_t GetCellKey(int x, BlockCell cell);
+		void UpdateCellHash(int y, int storageRow, uint64_t keyChange);
+
+		//key of the row hash at the line, empty lines don't change the hash of the board
+		inline uint64_t GetLineHash(int y) const
+		{
+			uint64_t rowHash = rowHashes[GetStorageRow(y)];
+
+			return (rowHash != 0) ? MixZobristBits(rowHash ^ GetZobristKey(ZOBRIST_LINE, (uint64_t)y)) : 0;
+		}
+
+		//Width and Height are 0 for grid sizes only known at runtime
+		template<int Width, int Height>
+		bool CanPieceExistAtSized(const PieceMask& pieceMask, Vector2Int position) const
+		{
+			const int width = (Width > 0) ? Width : size.x;
+			const int height = (Height > 0) ? Height : size.y;
+
+			//a piece without blocks fits anywhere
+			if (pieceMask.height == 0)
+				return true;
+
+			int left = position.x + pieceMask.left;
+			int top = position.y + pieceMask.top;
+
+			//if any block is out of bounds, then the piece can not exist at this position. Cells above the grid are empty.
+			if (left < 0 || left + pieceMask.width > width || top + pieceMask.height > height)
+				return false;
+
+			//if any block overlaps a non-empty cell, then the piece can not exist at this position either
+			for (int row = std::max(0, -top); row < pieceMask.height; row++)
+			{
+				if ((rowMasks[GetStorageRow(top + row)] & (pieceMask.rows[row] << left)) != 0)
+					return false;
+			}
+
+			return true;
+		}
+
+		template<int Width, int Height>
+		int GetDropDistanceSized(const PieceMask& pieceMask, Vector2Int position) const
+		{
+			//a piece without blocks can not land
+			if (pieceMask.height == 0)
+				return 0;
+
+			const int width = (Width > 0) ? Width : size.x;
+			int left = position.x + pieceMask.left;
+
+			//if every column of the piece is above the top of that grid column, the piece falls until one of them lands on it.
+			//Pieces that stick out to the sides can't move down at all, the fallback handles those.
+			if (pieceMask.width <= PIECE_MASK_MAX_COLUMNS && left >= 0 && left + pieceMask.width <= width)
+			{
+				int dropDistance = std::numeric_limits<int>::max();
+				bool isAboveStack = true;
+
+				for (int column = 0; column < pieceMask.width && isAboveStack; column++)
+				{
+					if (pieceMask.columnBottoms[column] < 0)
+						continue;
+
+					int bottomY = position.y + pieceMask.top + pieceMask.columnBottoms[column];
+					int columnDropDistance = columnTops[left + column] - 1 - bottomY;
+
+					if (columnDropDistance < 0)
+						isAboveStack = false;
+					else
+						dropDistance = std::min(dropDistance, columnDropDistance);
+				}
+
+				if (isAboveStack)
+					return dropDistance;
+			}
+
+			//tucked under an overhang, move down until it hits the grid
+			int dropDistance = 0;
+
+			while (CanPieceExistAtSized<Width, Height>(pieceMask, { position.x, position.y + dropDistance + 1 }))
+				dropDistance++;
+
+			return dropDistance;
+		}
+
+	public:
+		Board() = default;
+
+		Board(const Board&) = delete;
+		Board& operator=(const Board&) = delete;
+
+		~Board()
+		{
+			DeleteGrid();
+		}
+
+		void SetSize(Vector2Int size);
+		Vector2Int GetSize() const;
+
+		void Clear();
+
+		bool IsCellInBounds(int x, int y) const;
+		bool IsCellEmpty(int x, int y) const;
+
+		const BlockCell& GetCell(int x, int y) const;
+		void SetCell(int x, int y, BlockCell cell);
+		void SetCellState(int x, int y, BlockCellState state);
+
+		uint32_t GetRowMask(int y) const;
+		uint32_t GetFullRowMask() const;
+		/// Row mask of any line shifted left by BOARD_KICK_PADDING, with the walls on either side of the grid set. Lines below the grid are all walls.
+		uint64_t GetPaddedRowMask(int y) const;
+
+		int GetColumnTop(int x) const;
+		int GetColumnHeight(int x) const;
+		/// y of the highest non-empty cell, the grid's height if the board is empty
+		int GetStackTop() const;
+
+		bool IsLineFull(int y) const;
+		void ClearLine(int line);
+		bool InsertGarbageLine(int holeX, unsigned char colorIndex);
+
+		/// Zobrist hash of every cell's position, state and color. Boards with the same cells have the same hash.
+		uint64_t GetHash() const;
+
+		/// Writes the lines from the highest block down, an empty board only takes a single byte
+		void WriteSnapshot(SnapshotWriter& writer) const;
+		/// Clears the board and reads the blocks back in, the board must already have the size it was written with
+		bool ReadSnapshot(SnapshotReader& reader);
+
+		bool CanPieceExistAt(const Piece& piece, Vector2Int position) const;
+
+		/// Returns the index of the first offset from position that the piece can exist at, -1 if there is none.
+		/// The lines covered by all offsets are read once, after which each offset is a mask test per piece row.
+		int FindFittingOffset(const PieceMask& pieceMask, Vector2Int position, const Vector2Int* offsets, int numOffsets) const;
+		/// Columns of the piece, bit 0 being its leftmost one, that overlap blocks or walls at the given position
+		uint32_t GetBlockedColumns(const PieceMask& pieceMask, Vector2Int position) const;
+
+		inline bool CanPieceExistAt(const PieceMask& pieceMask, Vector2Int position) const
+		{
+			switch (sizeClass)
+			{
+				case BOARD_SIZE_10X20:
+					return CanPieceExistAtSized<10, 20>(pieceMask, position);
+				case BOARD_SIZE_10X40:
+					return CanPieceExistAtSized<10, 40>(pieceMask, position);
+				default:
+					return CanPieceExistAtSized<0, 0>(pieceMask, position);
+			}
+		}
+
+		//Returns how many rows the piece can move down from the given position, the piece must be able to exist there.
+		inline int GetDropDistance(const PieceMask& pieceMask, Vector2Int position) const
+		{
+			switch (sizeClass)
+			{
+				case BOARD_SIZE_10X20:
+					return GetDropDistanceSized<10, 20>(pieceMask, position);
+				case BOARD_SIZE_10X40:
+					return GetDropDistanceSized<10, 40>(pieceMask, position);
+				default:
+					return GetDropDistanceSized<0, 0>(pieceMask, position);
+			}
+		}
+};
\ No newline at end of file
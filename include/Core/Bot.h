@@ -0,0 +1,183 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "Vector2Int.h"
+#include "Core/Board.h"
+#include "Core/GameRules.h"
+#include "Core/MoveGenerator.h"
+#include "Core/Simulation.h"
+#include "Core/SimulationInput.h"
+#include "Core/TranspositionTable.h"
+
+//Boards a bot keeps after every placement of its search
+const int DEFAULT_BOT_BEAM_WIDTH = 64;
+
+//Time a bot takes to choose a placement, the placements of the current piece are always searched whole however long they take
+const float DEFAULT_BOT_TIME_BUDGET_SECONDS = 0.01f;
+
+//Score of a board the game ends on, below that of any other board
+const float BOT_GAME_OVER_SCORE = -1.0e9f;
+
+//What a bot does with the current piece: hold it, or move it to a placement
+struct BotDecision
+{
+	bool isHolding = false;
+	MovePlacement placement;
+	float score = 0.0f; //score of the best board the search found after it
+	int depth = 0; //placements searched ahead of the game
+};
+
+//Plays a game in place of the keyboard. Every time a new piece comes up it beam searches through the hold piece and the up and coming pieces:
+//each depth places the pieces of the kept boards at every placement they can reach, and keeps the best scoring boards for the next depth.
+//The boards of a depth are expanded by a pool of threads, the calling thread being one of them, and the results don't depend on the amount of threads.
+//Boards are scored with the El-Tetris weights (landing height, lines cleared, row and column transitions, holes and wells).
+//Board scores are kept in a transposition table keyed by the node hashes, which the threads and any bots given the same table share.
+class Bot
+{
+	private:
+		//Board and pieces after placements of the search, the lines are row masks from the top of the stack down
+		struct BotNode
+		{
+			int firstChoice = 0; //choice of the current piece the node comes from
+			int currentType = -1; //-1 if the piece isn't known yet
+			int currentRotation = 0;
+			Vector2Int currentPosition = Vector2Int{ 0, 0 };
+			int holdingType = -1;
+			int holdingRotation = 0;
+			bool canHold = true;
+			int nextPieceIndex = 0; //first up and coming piece that hasn't been used
+			bool isGameOver = false;
+
+			int stackTop = 0;
+			size_t linesStart = 0; //first line in the lines of its depth, only nodes kept in the beam have lines
+			int parentIndex = -1;
+			int placedType = -1; //piece placed on the parent, -1 if the node is its parent carried over
+			MovePlacement placement;
+
+			float reward = 0.0f; //worth of the placements that led to the node
+			float score = 0.0f; //reward plus the worth of the board
+			uint64_t linesHash = 0;
+			uint64_t hash = 0; //of the lines, current and holding piece and pieces still to come, nodes reached by placing pieces in another order are only kept once
+		};
+
+		//search state of a thread of the pool
+		struct BotWorker
+		{
+			MoveGenerator moveGenerator;
+			Board board;
+			std::vector<uint32_t> lines;
+		};
+
+		//rules of the game being searched
+		GameRules rules;
+		bool isGravityInstant = false;
+		std::vector<int> upAndComingPieceTypes;
+
+		int beamWidth = DEFAULT_BOT_BEAM_WIDTH;
+		float timeBudgetSeconds = DEFAULT_BOT_TIME_BUDGET_SECONDS;
+
+		//nodes of the depth being expanded, and the children of each of them
+		std::vector<BotNode> beam;
+		std::vector<uint32_t> beamLines;
+		std::vector<std::vector<BotNode>> children;
+		std::vector<BotDecision> firstChoices;
+		bool isExpandingRoot = false;
+		int expandingDepth = 0;
+
+		std::shared_ptr<TranspositionTable> transpositionTable = std::make_shared<TranspositionTable>();
+
+		//children of every node by score, node and child index pairs
+		std::vector<std::pair<int, int>> candidates;
+		std::vector<BotNode> nextBeam;
+		std::vector<uint32_t> nextBeamLines;
+		std::vector<uint32_t> placedLines;
+
+		//thread pool, workers[0] belongs to the calling thread
+		std::vector<std::unique_ptr<BotWorker>> workers;
+		std::vector<std::thread> threads;
+		std::mutex jobMutex;
+		std::condition_variable jobCondition;
+		std::condition_variable doneCondition;
+		uint64_t jobNumber = 0;
+		int numThreadsDone = 0;
+		bool isStopping = false;
+
+		std::atomic<int> nextJobNode = 0;
+		std::atomic<bool> isOutOfTime = false;
+		bool hasDeadline = false;
+		std::chrono::steady_clock::time_point deadline;
+
+		//the placement being moved to
+		bool hasPlannedDecision = false;
+		BotDecision plannedDecision;
+		uint64_t plannedDecisionKey = 0;
+		MoveGenerator pathGenerator;
+		std::vector<PieceMove> path;
+		std::vector<SimulationInput> plannedInputs;
+
+		//statistics of the last search
+		int lastSearchDepth = 0;
+		int64_t lastNumNodes = 0;
+		float lastSearchSeconds = 0.0f;
+
+		void RunThread(int workerIndex);
+		void RunJob(BotWorker& worker);
+		void ExpandBeam(bool isTimed);
+
+		void ExpandNode(BotWorker& worker, int nodeIndex);
+		int PlaceLines(const BotNode& parent, int type, const MovePlacement& placement, std::vector<uint32_t>& lines, int& stackTop) const;
+		void AddChild(BotWorker& worker, int nodeIndex, const BotNode& placing, int type, const MovePlacement& placement);
+		float ScoreLines(const uint32_t* lines, int numLines) const;
+
+		static uint64_t GetLineKey(int y, uint32_t line);
+		uint64_t HashLines(const uint32_t* lines, int stackTop) const;
+		uint64_t HashNode(const BotNode& node) const;
+
+		void SelectBeam();
+
+		static uint64_t GetDecisionKey(const Simulation& simulation);
+
+	public:
+		/// Starts numThreads - 1 threads for the pool, the thread calling the bot makes up the last one
+		Bot(int numThreads = 1);
+		~Bot();
+
+		Bot(const Bot&) = delete;
+		Bot& operator=(const Bot&) = delete;
+
+		int GetNumThreads() const;
+
+		void SetBeamWidth(int beamWidth);
+		int GetBeamWidth() const;
+
+		void SetTimeBudgetSeconds(float seconds);
+		float GetTimeBudgetSeconds() const;
+
+		/// Every bot has a table of its own, bots can share one by setting the same table, even while thinking at the same time, or search without one by setting null
+		void SetTranspositionTable(std::shared_ptr<TranspositionTable> transpositionTable);
+		const std::shared_ptr<TranspositionTable>& GetTranspositionTable() const;
+
+		/// Searches what to do with the current piece of the game, returns false if there is nothing to do (the game is over or clearing lines)
+		bool Think(const Simulation& simulation, BotDecision& decision);
+
+		/// Input for the next tick of the game. Thinks whenever a new piece comes up, then inputs the path to the chosen placement a tick at a time.
+		/// The path is found again from wherever the piece is every tick, so the piece falling on its own doesn't throw the bot off.
+		SimulationInput GetInput(const Simulation& simulation);
+		/// Inputs of the rest of the path to the chosen placement, as of the last GetInput
+		const std::vector<SimulationInput>& GetPlannedInputs() const;
+		/// Forgets the chosen placement, the next GetInput thinks again
+		void Reset();
+
+		int GetLastSearchDepth() const;
+		int64_t GetLastNumNodes() const;
+		float GetLastSearchSeconds() const;
+};
\ No newline at end of file
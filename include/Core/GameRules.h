@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+
+#include "Vector2Int.h"
+#include "Core/PieceSet.h"
+#include "Core/Randomizer.h"
+#include "Core/RotationSystem.h"
+#include "Core/Gravity.h"
+#include "Core/Snapshot.h"
+
+//Simulation steps per second, rates such as 60, 240 or 1000 are supported
+const int DEFAULT_TICK_RATE = 60;
+
+//Rules that affect how the simulation plays out, everything else is presentation
+struct GameRules
+{
+	int NumUpAndComingPieces;
+	Vector2Int GridSize;
+	RandomizerType Randomizer;
+	int TickRate;
+	std::shared_ptr<const PieceSet> Pieces;
+	RotationSystemType RotationSystem;
+	GravityType Gravity;
+
+	GameRules(int numUpAndComingPieces, Vector2Int gridSize, RandomizerType randomizer = RANDOMIZER_7_BAG, int tickRate = DEFAULT_TICK_RATE, std::shared_ptr<const PieceSet> pieces = PieceSet::GetStandard(),
+		RotationSystemType rotationSystem = ROTATION_CLASSIC, GravityType gravity = GRAVITY_CLASSIC)
+	{
+		NumUpAndComingPieces = numUpAndComingPieces;
+		GridSize = gridSize;
+		Randomizer = randomizer;
+		TickRate = tickRate;
+		Pieces = pieces;
+		RotationSystem = rotationSystem;
+		Gravity = gravity;
+	}
+
+	GameRules()
+	{
+		NumUpAndComingPieces = 3;
+		GridSize = Vector2Int(10, 20);
+		Randomizer = RANDOMIZER_7_BAG;
+		TickRate = DEFAULT_TICK_RATE;
+		Pieces = PieceSet::GetStandard();
+		RotationSystem = ROTATION_CLASSIC;
+		Gravity = GRAVITY_CLASSIC;
+	}
+
+	/// Same rules, piece sets are compared piece by piece
+	bool IsSameAs(const GameRules& rules) const;
+
+	/// Written at the start of snapshots and replays
+	void WriteSnapshot(SnapshotWriter& writer) const;
+	bool ReadSnapshot(SnapshotReader& reader);
+};
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+//How fast pieces fall as the level goes up
+enum GravityType
+{
+	GRAVITY_CLASSIC, //speeds up until level 15
+	GRAVITY_TO_20G, //keeps speeding up until pieces land right away
+	GRAVITY_20G, //pieces land right away on every level
+	NUM_GRAVITY_TYPES
+};
+
+const char* GetGravityTypeName(GravityType type);
+
+//Gravity is counted in fractions of a cell, a tick moves the piece down by the whole cells it has built up
+const int64_t GRAVITY_CELL_SCALE = (int64_t)1 << 32;
+
+//Levels with their own gravity, higher levels fall as fast as the last one
+const int GRAVITY_TABLE_LEVELS = 20;
+
+//20G, twenty cells every 60th of a second. Pieces this fast land within a single tick, however tall the grid is.
+const double MAX_GRAVITY_CELLS_PER_SECOND = 20.0 * 60.0;
+
+const double SOFT_DROP_CELLS_PER_SECOND = 20.0;
+
+/// Cells per second pieces fall at on the given level, from 1 up
+double GetGravityCellsPerSecond(GravityType type, int level);
\ No newline at end of file
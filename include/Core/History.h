@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+#include "Core/BlockCell.h"
+
+//Most cells in a line of a board, boards can be at most 31 cells wide
+const int HISTORY_LINE_MAX_CELLS = 32;
+
+//One line of the board in a list of lines going down to the bottom of the board.
+//Lines are never changed once created, so every version of the board that has the same lines below a line shares them.
+struct HistoryLine
+{
+	std::shared_ptr<HistoryLine> below; //next line down, null for the bottom line
+	int lineIndex; //counted from the bottom line of the board up
+	BlockCell cells[HISTORY_LINE_MAX_CELLS];
+
+	HistoryLine(std::shared_ptr<HistoryLine> below, int lineIndex)
+	{
+		this->below = std::move(below);
+		this->lineIndex = lineIndex;
+	}
+
+	//Frees the lines below that nothing else uses one by one, instead of recursing down the whole list
+	~HistoryLine()
+	{
+		std::shared_ptr<HistoryLine> line = std::move(below);
+
+		while (line != nullptr && line.use_count() == 1)
+			line = std::move(line->below);
+	}
+};
+
+//Game as it was right before a placement or hold
+struct HistoryEntry
+{
+	std::vector<uint8_t> state; //snapshot of everything except for the board
+	std::shared_ptr<HistoryLine> topLine; //highest line with blocks in it, null for an empty board
+};
\ No newline at end of file
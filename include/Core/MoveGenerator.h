@@ -0,0 +1,117 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "Vector2Int.h"
+#include "Core/Board.h"
+#include "Core/Piece.h"
+#include "Core/PieceMask.h"
+#include "Core/PieceSet.h"
+#include "Core/PieceTables.h"
+#include "Core/RotationSystem.h"
+#include "Core/SimulationInput.h"
+#include "Core/Simulation.h"
+
+//A single input that moves the current piece, paths to placements are sequences of them
+enum PieceMove
+{
+	MOVE_LEFT,
+	MOVE_RIGHT,
+	MOVE_ROTATE_CLOCKWISE,
+	MOVE_ROTATE_COUNTER_CLOCKWISE,
+	MOVE_ROTATE_HALF_CIRCLE,
+	MOVE_SOFT_DROP,
+	MOVE_HARD_DROP,
+	NUM_PIECE_MOVES
+};
+
+//Rotation and position a piece comes to rest at
+struct MovePlacement
+{
+	int rotation = 0;
+	Vector2Int position = Vector2Int{ 0, 0 };
+};
+
+//Finds every position a piece can come to rest at from where it is, under the same movement and rotation rules as the simulation:
+//every rotation, column, soft drop tuck and kick. The columns a piece can reach are searched a line at a time as a bit mask per rotation and line,
+//so a search is mostly mask operations and only kicks are tested one position at a time. Placements covering the same cells are returned once.
+//Paths assume the piece only moves down when it is soft dropped, a piece falling on its own while a path is being input can end up elsewhere.
+//Generators keep their buffers between searches, reuse them to avoid allocating.
+class MoveGenerator
+{
+	private:
+		//piece being searched, the board and piece set have to outlive the search for paths to be found
+		const Board* board = nullptr;
+		const PieceSet* pieceSet = nullptr;
+		RotationSystemType rotationSystem = ROTATION_CLASSIC;
+		int pieceType = -1;
+		bool canRotate = false;
+		PieceMask masks[NUM_PIECE_ROTATIONS];
+		int rotationClasses[NUM_PIECE_ROTATIONS]; //first rotation covering the same cells as each rotation, rotations of a class give the same placements
+		MovePlacement start;
+		bool isGravityInstant = false;
+
+		//piece origins that are searched, columns are bits of the masks starting at areaLeft
+		int areaLeft = 0;
+		int areaTop = 0;
+		int areaWidth = 0;
+		int areaHeight = 0;
+		uint64_t areaColumnsMask = 0;
+
+		//lines above the stack only have the walls to fit between, they fit the same columns in every such line
+		int stackTop = 0;
+		uint64_t openFitMasks[NUM_PIECE_ROTATIONS];
+		bool hasOpenFitMask[NUM_PIECE_ROTATIONS];
+
+		//column masks of a rotation and area line
+		struct MoveLine
+		{
+			uint64_t fitColumns = 0; //columns the piece fits at, computed the first time they're needed
+			uint64_t reachedColumns = 0; //columns the piece can be moved to
+			uint64_t expandedColumns = 0; //reached columns that have been moved from
+			uint64_t placedColumns = 0; //placements found so far, for lines of a rotation class
+			bool hasFitColumns = false;
+			bool isPending = false; //has reached columns left to move from
+		};
+
+		std::vector<MoveLine> lines; //per rotation and area line
+		std::vector<int> pendingLines;
+
+		std::vector<MovePlacement> placements;
+
+		//path search, a state per rotation, area line and column
+		std::vector<int> pathParents;
+		std::vector<uint8_t> pathMoves;
+		std::vector<int> pathQueue;
+
+		uint64_t GetFitMask(int rotation, int line);
+
+		void AddReached(int rotation, int line, uint64_t columns);
+		void ExpandLine(int index);
+
+		bool ApplyMove(PieceMove move, int& rotation, Vector2Int& position);
+		void AddPlacement(int rotation, Vector2Int position);
+
+		void GenerateInstant();
+		bool GetInstantPath(const MovePlacement& placement, std::vector<PieceMove>& path);
+
+	public:
+		/// Searches every placement of the piece from the given position, pieces that aren't from the piece set can move but not rotate.
+		/// If gravity is instant the piece can only rotate and move once before it lands, like pieces do in the tick they spawn in.
+		void Generate(const Board& board, RotationSystemType rotationSystem, const PieceSet& pieceSet, const Piece& piece, Vector2Int position, bool isGravityInstant);
+		/// Searches every placement of the current piece of the game, a game that is over has none
+		void Generate(const Simulation& simulation);
+
+		int GetNumPlacements() const;
+		const MovePlacement& GetPlacement(int index) const;
+		/// Index of the placement covering the same cells as the given one, -1 if the piece can't come to rest there
+		int FindPlacement(const MovePlacement& placement) const;
+
+		/// Finds one of the shortest paths from the start of the search to the placement, ending with a hard drop.
+		/// The board the search ran on must not have changed since. Returns false if index is out of range.
+		bool GetPath(int index, std::vector<PieceMove>& path);
+
+		/// Turns a path into the input of each tick it takes. A tick can rotate, move sideways and drop the piece once each, in that order, like the simulation does.
+		static void GetPathInputs(const std::vector<PieceMove>& path, std::vector<SimulationInput>& inputs);
+};
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <type_traits>
+
+#include "Vector2Int.h"
+#include "Vector2Float.h"
+#include "RectangleInt.h"
+#include "Core/BlockColor.h"
+
+enum MainPieceType
+{
+	PIECE_O = 0,
+	PIECE_I = 1,
+	PIECE_S = 2,
+	PIECE_Z = 3,
+	PIECE_L = 4,
+	PIECE_J = 5,
+	PIECE_T = 6
+};
+
+const int MAX_PIECE_BLOCKS = 8;
+
+//Trivially copyable, copying a piece never allocates
+struct Piece
+{
+	Vector2Float pivotOffset; //pivot to rotate around
+	Vector2Int blockOffsets[MAX_PIECE_BLOCKS]; //block offsets from origin, not pivot
+	int numBlocks; //amount of blocks
+	unsigned char colorIndex; //index into BLOCK_PALETTE
+	int type; //index into the piece set the piece came from (MainPieceType for the standard set), -1 if this isn't from a piece set
+	int rotation; //amount of clockwise quarter turns from the spawn rotation
+
+	Piece GetClockwiseRotation() const;
+	Piece GetCounterClockwiseRotation() const;
+	Piece GetHalfCircleRotation() const;
+
+	Vector2Int Measure() const;
+	RectangleInt GetBounds() const;
+
+	static Piece GetMainPiece(MainPieceType mainPieceType);
+
+	Piece()
+	{
+		pivotOffset = Vector2Float{ 0.0f, 0.0f };
+		numBlocks = 0;
+		colorIndex = 0;
+		type = -1;
+		rotation = 0;
+	}
+
+	Piece(int numBlocks)
+	{
+		pivotOffset = Vector2Float{ 0.0f, 0.0f };
+		this->numBlocks = numBlocks;
+		colorIndex = 0;
+		type = -1;
+		rotation = 0;
+	}
+
+	Piece(Vector2Float pivotOffset, const Vector2Int* blockOffsets, int numBlocks, unsigned char colorIndex)
+	{
+		this->pivotOffset = pivotOffset;
+
+		for (int i = 0; i < numBlocks; i++)
+			this->blockOffsets[i] = blockOffsets[i];
+
+		this->numBlocks = numBlocks;
+		this->colorIndex = colorIndex;
+		type = -1;
+		rotation = 0;
+	}
+};
+
+static_assert(std::is_trivially_copyable<Piece>::value, "Pieces are copied around constantly and must not allocate");
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+
+#include "Vector2Int.h"
+#include "Core/Piece.h"
+
+const int PIECE_MASK_MAX_ROWS = 8;
+const int PIECE_MASK_MAX_COLUMNS = 8;
+
+//Occupancy of a piece as one bit mask per row, for collision checks against the board's row masks
+struct PieceMask
+{
+	uint32_t rows[PIECE_MASK_MAX_ROWS]; //bit 0 is the leftmost column of the piece
+	int left; //offset of the leftmost column from the piece origin
+	int top; //offset of the top row from the piece origin
+	int width;
+	int height;
+	int columnBottoms[PIECE_MASK_MAX_COLUMNS]; //row of the lowest block in each of the first PIECE_MASK_MAX_COLUMNS columns, -1 if the column has no blocks
+
+	constexpr PieceMask()
+	{
+		for (int i = 0; i < PIECE_MASK_MAX_ROWS; i++)
+			rows[i] = 0;
+
+		for (int i = 0; i < PIECE_MASK_MAX_COLUMNS; i++)
+			columnBottoms[i] = -1;
+
+		left = 0;
+		top = 0;
+		width = 0;
+		height = 0;
+	}
+
+	/// Builds the row masks of the given blocks, they can span at most 32 columns and PIECE_MASK_MAX_ROWS rows
+	static constexpr PieceMask FromBlocks(const Vector2Int* blockOffsets, int numBlocks)
+	{
+		PieceMask mask = PieceMask();
+
+		if (numBlocks == 0)
+			return mask;
+
+		int left = blockOffsets[0].x;
+		int right = blockOffsets[0].x;
+
+		int top = blockOffsets[0].y;
+		int bottom = blockOffsets[0].y;
+
+		for (int i = 1; i < numBlocks; i++)
+		{
+			left = std::min(left, blockOffsets[i].x);
+			right = std::max(right, blockOffsets[i].x);
+
+			top = std::min(top, blockOffsets[i].y);
+			bottom = std::max(bottom, blockOffsets[i].y);
+		}
+
+		mask.left = left;
+		mask.top = top;
+		mask.width = right - left + 1;
+		mask.height = bottom - top + 1;
+
+		for (int i = 0; i < numBlocks; i++)
+		{
+			int row = blockOffsets[i].y - top;
+			int column = blockOffsets[i].x - left;
+
+			if (row < PIECE_MASK_MAX_ROWS && column < 32)
+				mask.rows[row] |= 1u << column;
+
+			if (column < PIECE_MASK_MAX_COLUMNS)
+				mask.columnBottoms[column] = std::max(mask.columnBottoms[column], row);
+		}
+
+		return mask;
+	}
+
+	static PieceMask FromPiece(const Piece& piece);
+};
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "Vector2Int.h"
+#include "Vector2Float.h"
+#include "Core/Piece.h"
+#include "Core/PieceTables.h"
+#include "Core/Snapshot.h"
+
+//Most pieces in a set, piece types are stored in a byte in snapshots and replays
+const int PIECE_SET_MAX_PIECES = 64;
+
+//Blocks can be at most this far from the piece origin in any rotation, so a piece is always within the guard band of the board
+const int PIECE_SET_MAX_BLOCK_OFFSET = 4;
+
+struct PieceDefinition
+{
+	Vector2Float pivotOffset; //pivot to rotate around
+	Vector2Int blockOffsets[MAX_PIECE_BLOCKS]; //block offsets of the spawn rotation
+	int numBlocks;
+	unsigned char colorIndex; //index into BLOCK_PALETTE
+
+	PieceDefinition()
+	{
+		pivotOffset = Vector2Float(0.0f, 0.0f);
+		numBlocks = 0;
+		colorIndex = PALETTE_BLANK;
+	}
+};
+
+//Pieces a game deals out, piece types are indices into the set. Every piece is compiled into a shape per rotation when it is added,
+//the same tables the standard pieces are compiled into at compile time, so any set plays as fast as the standard one.
+class PieceSet
+{
+	private:
+		std::string name;
+		bool isStandard = false;
+
+		std::vector<PieceDefinition> definitions;
+		std::vector<PieceShape> shapes; //NUM_PIECE_ROTATIONS shapes per piece, rotation 0 is the spawn rotation
+
+	public:
+		PieceSet(std::string name);
+
+		/// The seven main pieces, in MainPieceType order
+		static std::shared_ptr<const PieceSet> GetStandard();
+
+		/// Reads a piece set from its definition text, returns null and sets error if it is invalid
+		static std::shared_ptr<PieceSet> Load(const std::string& text, std::string& error);
+		static std::shared_ptr<PieceSet> LoadFromFile(const std::string& path, std::string& error);
+
+		/// Compiles the piece and adds it as the next piece type, returns false if it is invalid or the set is full
+		bool AddPiece(const PieceDefinition& definition);
+
+		const std::string& GetName() const;
+		bool IsStandard() const;
+
+		int GetNumPieces() const;
+		const PieceDefinition& GetDefinition(int type) const;
+
+		/// Piece of the given type in its spawn rotation
+		Piece GetPiece(int type) const;
+
+		inline const PieceShape& GetShape(int type, int rotation) const
+		{
+			return shapes[type * NUM_PIECE_ROTATIONS + rotation];
+		}
+
+		/// Same name and the same pieces in the same order
+		bool IsSameAs(const PieceSet& pieceSet) const;
+
+		void WriteSnapshot(SnapshotWriter& writer) const;
+		static std::shared_ptr<const PieceSet> ReadSnapshot(SnapshotReader& reader);
+};
\ No newline at end of file
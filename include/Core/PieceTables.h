@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Vector2Int.h"
+#include "Vector2Float.h"
+#include "Core/BlockColor.h"
+#include "Core/Piece.h"
+#include "Core/PieceMask.h"
+
+const int NUM_MAIN_PIECES = 7;
+const int NUM_MAIN_PIECE_BLOCKS = 4;
+const int NUM_PIECE_ROTATIONS = 4;
+
+//One rotation state of a piece: its blocks, bounding box and row masks
+struct PieceShape
+{
+	Vector2Int blockOffsets[MAX_PIECE_BLOCKS]; //block offsets from origin, not pivot
+	int numBlocks;
+	PieceMask mask;
+
+	constexpr PieceShape()
+	{
+		numBlocks = 0;
+	}
+
+	/// Rotates 90 degrees clockwise around the pivot, rounding the same way as Piece::GetClockwiseRotation
+	constexpr PieceShape GetClockwiseRotation(Vector2Float pivotOffset) const
+	{
+		PieceShape rotatedShape = PieceShape();
+		rotatedShape.numBlocks = numBlocks;
+
+		for (int i = 0; i < numBlocks; i++)
+		{
+			rotatedShape.blockOffsets[i].x = (int)(-blockOffsets[i].y + pivotOffset.y + pivotOffset.x);
+			rotatedShape.blockOffsets[i].y = (int)(blockOffsets[i].x - pivotOffset.x + pivotOffset.y);
+		}
+
+		rotatedShape.mask = PieceMask::FromBlocks(rotatedShape.blockOffsets, numBlocks);
+
+		return rotatedShape;
+	}
+};
+
+struct MainPieceDefinition
+{
+	Vector2Float pivotOffset; //pivot to rotate around
+	Vector2Int blockOffsets[NUM_MAIN_PIECE_BLOCKS]; //block offsets of the spawn rotation
+	unsigned char colorIndex; //index into BLOCK_PALETTE
+};
+
+//Indexed by MainPieceType
+inline constexpr MainPieceDefinition MAIN_PIECE_DEFINITIONS[NUM_MAIN_PIECES] =
+{
+	//O
+	{ Vector2Float(0.5f, 0.5f), { Vector2Int(0, 0), Vector2Int(1, 0), Vector2Int(0, 1), Vector2Int(1, 1) }, PALETTE_YELLOW },
+	//I
+	{ Vector2Float(0.5f, 0.5f), { Vector2Int(1, -1), Vector2Int(1, 0), Vector2Int(1, 1), Vector2Int(1, 2) }, PALETTE_SKY_BLUE },
+	//S
+	{ Vector2Float(0.0f, 0.0f), { Vector2Int(0, 0), Vector2Int(1, 0), Vector2Int(0, -1), Vector2Int(-1, -1) }, PALETTE_RED },
+	//Z
+	{ Vector2Float(0.0f, 0.0f), { Vector2Int(0, 0), Vector2Int(-1, 0), Vector2Int(0, -1), Vector2Int(1, -1) }, PALETTE_GREEN },
+	//L
+	{ Vector2Float(0.0f, 0.0f), { Vector2Int(0, -1), Vector2Int(0, 0), Vector2Int(0, 1), Vector2Int(1, -1) }, PALETTE_ORANGE },
+	//J
+	{ Vector2Float(0.0f, 0.0f), { Vector2Int(0, -1), Vector2Int(0, 0), Vector2Int(0, 1), Vector2Int(-1, -1) }, PALETTE_PINK },
+	//T
+	{ Vector2Float(0.0f, 0.0f), { Vector2Int(-1, 0), Vector2Int(0, 0), Vector2Int(1, 0), Vector2Int(0, 1) }, PALETTE_PURPLE }
+};
+
+struct MainPieceShapeTable
+{
+	PieceShape shapes[NUM_MAIN_PIECES][NUM_PIECE_ROTATIONS]; //rotation 0 is the spawn rotation, each next one is rotated clockwise
+};
+
+constexpr MainPieceShapeTable BuildMainPieceShapeTable()
+{
+	MainPieceShapeTable table = MainPieceShapeTable();
+
+	for (int type = 0; type < NUM_MAIN_PIECES; type++)
+	{
+		PieceShape shape = PieceShape();
+		shape.numBlocks = NUM_MAIN_PIECE_BLOCKS;
+
+		for (int i = 0; i < NUM_MAIN_PIECE_BLOCKS; i++)
+			shape.blockOffsets[i] = MAIN_PIECE_DEFINITIONS[type].blockOffsets[i];
+
+		shape.mask = PieceMask::FromBlocks(shape.blockOffsets, shape.numBlocks);
+
+		for (int rotation = 0; rotation < NUM_PIECE_ROTATIONS; rotation++)
+		{
+			table.shapes[type][rotation] = shape;
+			shape = shape.GetClockwiseRotation(MAIN_PIECE_DEFINITIONS[type].pivotOffset);
+		}
+	}
+
+	return table;
+}
+
+//Generated at compile time, rotating a main piece is a lookup in this table
+inline constexpr MainPieceShapeTable MAIN_PIECE_SHAPES = BuildMainPieceShapeTable();
+
+static_assert(MAIN_PIECE_SHAPES.shapes[PIECE_I][1].mask.width == 4 && MAIN_PIECE_SHAPES.shapes[PIECE_I][1].mask.height == 1, "I piece should lie flat after one clockwise rotation");
+static_assert(MAIN_PIECE_SHAPES.shapes[PIECE_O][3].mask.rows[0] == 0b11 && MAIN_PIECE_SHAPES.shapes[PIECE_O][3].mask.rows[1] == 0b11, "O piece should look the same in every rotation");
+
+inline const PieceShape& GetMainPieceShape(MainPieceType mainPieceType, int rotation)
+{
+	return MAIN_PIECE_SHAPES.shapes[mainPieceType][rotation];
+}
\ No newline at end of file
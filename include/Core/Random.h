@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Core/Snapshot.h"
+
+//Small and fast pseudo random number generator (xoshiro128**), every instance has its own state.
+//The same seed gives the same numbers on every platform.
+class Random
+{
+	private:
+		uint32_t state[4];
+
+	public:
+		Random(uint64_t seed = 0);
+
+		void Seed(uint64_t seed);
+
+		uint32_t Next();
+
+		/// Returns a random value between min and max (both included), every value is equally likely
+		int GetValue(int min, int max);
+
+		void WriteSnapshot(SnapshotWriter& writer) const;
+		bool ReadSnapshot(SnapshotReader& reader);
+};
\ No newline at end of file
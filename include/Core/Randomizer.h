@@ -0,0 +1,84 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Core/Piece.h"
+#include "Core/PieceTables.h"
+#include "Core/PieceSet.h"
+#include "Core/Random.h"
+#include "Core/Snapshot.h"
+
+enum RandomizerType
+{
+	RANDOMIZER_7_BAG,
+	RANDOMIZER_14_BAG,
+	RANDOMIZER_HISTORY,
+	NUM_RANDOMIZER_TYPES
+};
+
+const char* GetRandomizerTypeName(RandomizerType type);
+
+//Picks the order in which the pieces of a piece set come, using the random number generator of the game it belongs to
+class Randomizer
+{
+	public:
+		virtual ~Randomizer() = default;
+
+		/// Forgets about previously picked pieces, for a new game
+		virtual void Reset() = 0;
+
+		/// Type of the next piece, an index into the piece set
+		virtual int Next(Random& random) = 0;
+
+		/// Writes the pieces remembered by the randomizer, reading them back continues with the exact same pieces
+		virtual void WriteSnapshot(SnapshotWriter& writer) const = 0;
+		virtual bool ReadSnapshot(SnapshotReader& reader) = 0;
+
+		static std::unique_ptr<Randomizer> Create(RandomizerType type, const PieceSet& pieceSet);
+};
+
+const int BAG_RANDOMIZER_MAX_COPIES = 2;
+
+//Shuffles a number of copies of every piece into a bag, then deals out the whole bag before refilling it
+class BagRandomizer : public Randomizer
+{
+	private:
+		std::vector<int> bagPieceTypes;
+		int numPieceTypes;
+		int bagSize;
+		int bagIndex;
+
+		void RefillBag(Random& random);
+
+	public:
+		BagRandomizer(int numPieceTypes, int numCopies);
+
+		void Reset() override;
+		int Next(Random& random) override;
+
+		void WriteSnapshot(SnapshotWriter& writer) const override;
+		bool ReadSnapshot(SnapshotReader& reader) override;
+};
+
+const int HISTORY_RANDOMIZER_SIZE = 4;
+const int HISTORY_RANDOMIZER_ROLLS = 6;
+
+//Rolls a few times to avoid the most recently picked pieces. With the standard pieces it never starts with an S, Z or O piece.
+class HistoryRandomizer : public Randomizer
+{
+	private:
+		int history[HISTORY_RANDOMIZER_SIZE]; //-1 for no piece
+		int numPieceTypes;
+		bool isStandardPieceSet;
+		bool isFirstPiece;
+
+	public:
+		HistoryRandomizer(int numPieceTypes, bool isStandardPieceSet);
+
+		void Reset() override;
+		int Next(Random& random) override;
+
+		void WriteSnapshot(SnapshotWriter& writer) const override;
+		bool ReadSnapshot(SnapshotReader& reader) override;
+};
\ No newline at end of file
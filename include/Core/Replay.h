@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Core/GameRules.h"
+#include "Core/Simulation.h"
+#include "Core/SimulationInput.h"
+#include "Core/Snapshot.h"
+
+//Current version of the replay format, bump it whenever the layout of a replay or of the rules in it changes
+const int REPLAY_VERSION = 4;
+
+//Extension of replay files
+const char* const REPLAY_FILE_EXTENSION = ".kreplay";
+
+//Default time between keyframes, seeking re-simulates at most this much of the game
+const int REPLAY_KEYFRAME_INTERVAL_SECONDS = 30;
+
+//A run of ticks that all got the same input
+struct ReplayInputRun
+{
+	uint32_t numTicks;
+	uint8_t down;
+	uint8_t pressed;
+};
+
+//Zobrist hash of the game right after a tick that placed a piece, the lower half of Simulation::GetZobristHash.
+//Playing back checks them, so a game that goes out of sync is caught at the placement it happened at.
+struct ReplayPlacementHash
+{
+	int64_t tick;
+	uint32_t hash;
+};
+
+//Snapshot of the game after a number of ticks, stored in the keyframe data of the replay
+struct ReplayKeyframe
+{
+	int64_t tick;
+	size_t dataOffset;
+	size_t dataSize;
+};
+
+//How the game stood when the recording stopped, playing the replay back has to end up the same
+struct ReplayResult
+{
+	int64_t ticksPlayed = 0;
+	int score = 0;
+	int level = 1;
+	int totalLinesCleared = 0;
+	bool gameOver = false;
+	uint64_t stateHash = 0; //Simulation::GetStateHash
+
+	static ReplayResult FromSimulation(const Simulation& simulation);
+
+	bool IsSameAs(const ReplayResult& result) const;
+};
+
+//A game from its start: the rules, the seed and the input of every tick, run length encoded.
+//A simulation started with the same rules and seed that gets the same inputs plays out the exact same game.
+//Snapshots taken every so often serve as keyframes, so any tick can be reached without playing the game from the start.
+class Replay
+{
+	friend class ReplayRecorder;
+
+	private:
+		GameRules rules;
+		uint64_t seed = 0;
+
+		std::vector<ReplayInputRun> inputRuns;
+		std::vector<int64_t> inputRunEndTicks; //tick right after each run, to look up the run of a tick
+		int64_t numTicks = 0;
+
+		//ordered by tick
+		std::vector<ReplayPlacementHash> placementHashes;
+
+		//ordered by tick, the snapshots are stored one after another in keyframeData
+		std::vector<ReplayKeyframe> keyframes;
+		std::vector<uint8_t> keyframeData;
+
+		ReplayResult result;
+
+	public:
+		const GameRules& GetRules() const;
+		uint64_t GetSeed() const;
+
+		int64_t GetNumTicks() const;
+		int GetNumInputRuns() const;
+		const ReplayInputRun& GetInputRun(int index) const;
+		/// Run that holds the input of the tick, GetNumInputRuns() if the tick is past the end
+		int FindInputRun(int64_t tick) const;
+		/// Tick the run starts at
+		int64_t GetInputRunStartTick(int index) const;
+
+		int GetNumPlacementHashes() const;
+		const ReplayPlacementHash& GetPlacementHash(int index) const;
+		/// First placement hash after the tick, GetNumPlacementHashes() if there is none
+		int FindPlacementHash(int64_t tick) const;
+
+		int GetNumKeyframes() const;
+		const ReplayKeyframe& GetKeyframe(int index) const;
+		const uint8_t* GetKeyframeData(const ReplayKeyframe& keyframe) const;
+		/// Last keyframe at or before the tick, -1 if there is none
+		int FindKeyframe(int64_t tick) const;
+
+		const ReplayResult& GetResult() const;
+
+		/// Appends the replay to data, a run of ticks takes 3 bytes or more, a placement about 5 and a keyframe a snapshot.
+		/// The keyframes come last, after an index of their ticks and sizes.
+		void Save(std::vector<uint8_t>& data) const;
+		/// Returns false if the replay is invalid or of another version
+		bool Load(const uint8_t* data, size_t size);
+
+		bool SaveToFile(const std::string& path) const;
+		bool LoadFromFile(const std::string& path, std::string& error);
+};
+
+//Records the input of every tick of a game while stepping it
+class ReplayRecorder
+{
+	private:
+		Replay replay;
+
+		int keyframeIntervalSeconds = REPLAY_KEYFRAME_INTERVAL_SECONDS;
+		int64_t keyframeIntervalTicks = 0;
+
+	public:
+		/// Time between keyframes of the next recordings, 0 to not take any
+		void SetKeyframeIntervalSeconds(int seconds);
+
+		/// Starts the simulation with the rules and seed and starts a new recording of it
+		void Start(Simulation& simulation, const GameRules& rules, uint64_t seed);
+
+		/// Steps the simulation with the input and records it. Undoing during a recording makes the replay play out differently.
+		unsigned int Step(Simulation& simulation, const SimulationInput& input);
+
+		/// Keeps how the game stands now as the result of the replay
+		void Finish(const Simulation& simulation);
+
+		const Replay& GetReplay() const;
+};
+
+//Feeds the input of a replay to a simulation, in place of live input
+class ReplayPlayer
+{
+	private:
+		const Replay* replay;
+
+		int runIndex = 0;
+		uint32_t runTick = 0;
+		int64_t tick = 0;
+
+		int placementHashIndex = 0; //next placement hash to check
+		int64_t desyncTick = -1;
+
+		void SetTick(int64_t tick);
+
+	public:
+		/// The replay has to outlive the player
+		ReplayPlayer(const Replay& replay)
+		{
+			this->replay = &replay;
+		}
+
+		/// Starts the simulation with the rules and seed of the replay, from the first tick
+		void Start(Simulation& simulation);
+
+		/// Whether every tick of the replay has been played
+		bool IsAtEnd() const;
+		int64_t GetTick() const;
+
+		/// Input of the next tick, no input once the replay is at its end
+		SimulationInput NextInput();
+
+		/// Steps the simulation with the input of the next tick, returns the SimulationEvent flags raised.
+		/// Placements are checked against the replay's placement hashes. Does nothing once the replay is at its end.
+		unsigned int Step(Simulation& simulation);
+
+		/// First tick at which a piece was placed differently than in the recording, -1 while the game is in sync.
+		/// Starting again forgets it.
+		int64_t GetDesyncTick() const;
+
+		/// Brings the simulation to the tick, forwards or backwards, from the closest keyframe or from where it is if that is closer.
+		/// The simulation has to be at the player's tick. Returns false if a keyframe couldn't be loaded, the simulation is at GetTick() either way.
+		bool Seek(Simulation& simulation, int64_t tick);
+
+		/// Plays every remaining tick, returns whether the game ended up the way it was recorded
+		bool PlayToEnd(Simulation& simulation);
+};
+
+/// Appends the path if it is a file, or every replay file in it and its subdirectories if it is a directory
+void FindReplayFiles(const std::string& path, std::vector<std::string>& paths);
\ No newline at end of file
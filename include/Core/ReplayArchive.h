@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Core/Replay.h"
+
+//Current version of the archive format, bump it whenever a column is added, removed or changes type
+const int REPLAY_ARCHIVE_VERSION = 1;
+
+//Extension of replay archive files
+const char* const REPLAY_ARCHIVE_FILE_EXTENSION = ".karchive";
+
+//Columns of a replay archive, stored in this order. Each column is an array of one value per game, per placement or per level run.
+enum ReplayArchiveColumn
+{
+	//games
+	ARCHIVE_GAME_SEEDS,
+	ARCHIVE_GAME_FIRST_PLACEMENTS,
+	ARCHIVE_GAME_NUM_PLACEMENTS,
+	ARCHIVE_GAME_TICKS_PLAYED,
+	ARCHIVE_GAME_TICK_RATES,
+	ARCHIVE_GAME_SCORES,
+	ARCHIVE_GAME_LEVELS,
+	ARCHIVE_GAME_LINES_CLEARED,
+	ARCHIVE_GAME_HOLE_COLUMNS,
+	ARCHIVE_GAME_OVER,
+
+	//placements
+	ARCHIVE_PLACEMENT_TICKS,
+	ARCHIVE_PLACEMENT_LEVELS,
+	ARCHIVE_PLACEMENT_STACK_HEIGHTS,
+	ARCHIVE_PLACEMENT_PIECE_TYPES,
+	ARCHIVE_PLACEMENT_ROTATIONS,
+	ARCHIVE_PLACEMENT_COLUMNS,
+	ARCHIVE_PLACEMENT_LINES_CLEARED,
+
+	//level index
+	ARCHIVE_LEVEL_RUN_LEVELS,
+	ARCHIVE_LEVEL_RUN_GAMES,
+	ARCHIVE_LEVEL_RUN_FIRST_PLACEMENTS,
+	ARCHIVE_LEVEL_RUN_NUM_PLACEMENTS,
+
+	NUM_ARCHIVE_COLUMNS
+};
+
+//Columns of every game, index them with the game
+struct ReplayArchiveGames
+{
+	const uint64_t* seeds;
+	const uint64_t* firstPlacements; //placements of a game come one after another
+	const uint32_t* numPlacements;
+	const uint64_t* ticksPlayed;
+	const uint32_t* tickRates;
+	const int32_t* scores;
+	const int32_t* levels;
+	const int32_t* linesCleared;
+	const uint32_t* holeColumns; //bit x is set if column x has an empty cell below its top when the game ended
+	const uint8_t* gameOver;
+};
+
+//Columns of every placement of every game, index them with the placement
+struct ReplayArchivePlacements
+{
+	const uint32_t* ticks; //from the start of the game, the placement happened during this tick
+	const uint16_t* levels; //level when the piece was placed
+	const uint16_t* stackHeights; //height of the highest column after placing, lines about to be cleared included
+	const uint8_t* pieceTypes;
+	const uint8_t* rotations;
+	const int8_t* columns; //leftmost column of the piece
+	const uint8_t* linesCleared;
+};
+
+//Index of the placements by level: the placements a game made at a level, ordered by level and then by game
+struct ReplayArchiveLevelRuns
+{
+	const uint32_t* levels;
+	const uint32_t* games;
+	const uint64_t* firstPlacements;
+	const uint32_t* numPlacements;
+};
+
+//Collects the placements of replays by playing them back, then saves them as an archive
+class ReplayArchiveBuilder
+{
+	private:
+		std::vector<uint64_t> gameSeeds;
+		std::vector<uint64_t> gameFirstPlacements;
+		std::vector<uint32_t> gameNumPlacements;
+		std::vector<uint64_t> gameTicksPlayed;
+		std::vector<uint32_t> gameTickRates;
+		std::vector<int32_t> gameScores;
+		std::vector<int32_t> gameLevels;
+		std::vector<int32_t> gameLinesCleared;
+		std::vector<uint32_t> gameHoleColumns;
+		std::vector<uint8_t> gameOver;
+
+		std::vector<uint32_t> placementTicks;
+		std::vector<uint16_t> placementLevels;
+		std::vector<uint16_t> placementStackHeights;
+		std::vector<uint8_t> placementPieceTypes;
+		std::vector<uint8_t> placementRotations;
+		std::vector<int8_t> placementColumns;
+		std::vector<uint8_t> placementLinesCleared;
+
+		void AddPlacement(const Simulation& simulation, int64_t tick);
+		void RemovePlacementsFrom(size_t firstPlacement);
+
+	public:
+		/// Plays the replay back and adds its placements. Returns false, adding nothing, if it doesn't play back the way it was recorded.
+		bool AddReplay(const Replay& replay);
+		/// Adds every game of the other builder after the games of this one
+		void Append(const ReplayArchiveBuilder& other);
+
+		size_t GetNumGames() const;
+		size_t GetNumPlacements() const;
+
+		/// Writes the archive along with its level index
+		bool SaveToFile(const std::string& path) const;
+};
+
+//Archive of the placements of many games, mapped into memory and read in place.
+//The columns point straight into the file, so opening an archive of any size is instant and scans only touch the columns they read.
+class ReplayArchive
+{
+	private:
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+
+		size_t numGames = 0;
+		size_t numPlacements = 0;
+		size_t numLevelRuns = 0;
+
+		ReplayArchiveGames games = ReplayArchiveGames();
+		ReplayArchivePlacements placements = ReplayArchivePlacements();
+		ReplayArchiveLevelRuns levelRuns = ReplayArchiveLevelRuns();
+
+		bool MapColumns();
+
+	public:
+		ReplayArchive() = default;
+
+		ReplayArchive(const ReplayArchive&) = delete;
+		ReplayArchive& operator=(const ReplayArchive&) = delete;
+
+		~ReplayArchive()
+		{
+			Close();
+		}
+
+		/// Maps the archive into memory, returns false if it can't be read or isn't a valid archive of this version
+		bool Open(const std::string& path, std::string& error);
+		void Close();
+
+		size_t GetNumGames() const;
+		size_t GetNumPlacements() const;
+		size_t GetNumLevelRuns() const;
+
+		const ReplayArchiveGames& GetGames() const;
+		const ReplayArchivePlacements& GetPlacements() const;
+		const ReplayArchiveLevelRuns& GetLevelRuns() const;
+
+		/// First level run at or above the level, GetNumLevelRuns() if there is none
+		size_t FindLevelRun(int level) const;
+};
\ No newline at end of file
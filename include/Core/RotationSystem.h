@@ -0,0 +1,163 @@
+#pragma once
+
+#include "Vector2Int.h"
+#include "Core/Piece.h"
+#include "Core/PieceTables.h"
+#include "Core/PieceSet.h"
+#include "Core/Board.h"
+
+//How pieces are moved when they can't rotate in place
+enum RotationSystemType
+{
+	ROTATION_CLASSIC, //moves the piece away from whatever blocks it, by the width of the blocked columns
+	ROTATION_SRS, //Super Rotation System wall and floor kicks
+	ROTATION_ARS, //Arika Rotation System, one column to the right or left
+	NUM_ROTATION_SYSTEM_TYPES
+};
+
+const char* GetRotationSystemTypeName(RotationSystemType type);
+
+//Pieces sharing a kick table
+enum RotationKickClass
+{
+	KICK_CLASS_DEFAULT, //J, L, S, T, Z and the pieces of custom sets
+	KICK_CLASS_I,
+	KICK_CLASS_O,
+	NUM_KICK_CLASSES
+};
+
+//Indexed by MainPieceType
+inline constexpr RotationKickClass MAIN_PIECE_KICK_CLASSES[NUM_MAIN_PIECES] = { KICK_CLASS_O, KICK_CLASS_I, KICK_CLASS_DEFAULT, KICK_CLASS_DEFAULT, KICK_CLASS_DEFAULT, KICK_CLASS_DEFAULT, KICK_CLASS_DEFAULT };
+
+//SRS rotation state of the spawn rotation of each main piece, indexed by MainPieceType.
+//The I, J, L and T pieces don't spawn in the SRS spawn state, their kicks are looked up from the state they are actually in.
+inline constexpr int MAIN_PIECE_SRS_SPAWN_STATES[NUM_MAIN_PIECES] = { 0, 1, 0, 0, 1, 3, 2 };
+
+const int MAX_ROTATION_KICKS = 5;
+
+//Offsets to try a rotated piece at, in order, the first one the piece fits at is taken
+struct RotationKicks
+{
+	Vector2Int offsets[MAX_ROTATION_KICKS];
+	int numOffsets;
+	bool isScaledByBlockedWidth; //x offsets are multiplied by the width of the columns blocking the piece at its position
+
+	constexpr RotationKicks()
+	{
+		numOffsets = 0;
+		isScaledByBlockedWidth = false;
+	}
+};
+
+struct RotationKickTable
+{
+	RotationKicks kicks[NUM_ROTATION_SYSTEM_TYPES][NUM_KICK_CLASSES][NUM_PIECE_ROTATIONS][NUM_PIECE_ROTATIONS]; //from and to rotation
+};
+
+//SRS offset data per kick class and rotation state (0, R, 2, L), y goes up. The kicks of a rotation are the offsets of the state it
+//starts in minus those of the state it ends in, relative to the first test since pieces here already rotate around their true center.
+inline constexpr Vector2Int SRS_OFFSETS[NUM_KICK_CLASSES][NUM_PIECE_ROTATIONS][MAX_ROTATION_KICKS] =
+{
+	//J, L, S, T, Z
+	{
+		{ Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0) },
+		{ Vector2Int(0, 0), Vector2Int(1, 0), Vector2Int(1, -1), Vector2Int(0, 2), Vector2Int(1, 2) },
+		{ Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0) },
+		{ Vector2Int(0, 0), Vector2Int(-1, 0), Vector2Int(-1, -1), Vector2Int(0, 2), Vector2Int(-1, 2) }
+	},
+	//I
+	{
+		{ Vector2Int(0, 0), Vector2Int(-1, 0), Vector2Int(2, 0), Vector2Int(-1, 0), Vector2Int(2, 0) },
+		{ Vector2Int(-1, 0), Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 1), Vector2Int(0, -2) },
+		{ Vector2Int(-1, 1), Vector2Int(1, 1), Vector2Int(-2, 1), Vector2Int(1, 0), Vector2Int(-2, 0) },
+		{ Vector2Int(0, 1), Vector2Int(0, 1), Vector2Int(0, 1), Vector2Int(0, -1), Vector2Int(0, 2) }
+	},
+	//O, never kicks
+	{
+		{ Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0) },
+		{ Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0) },
+		{ Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0) },
+		{ Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0), Vector2Int(0, 0) }
+	}
+};
+
+//adds the offset unless the kicks already contain it, testing the same offset twice is pointless
+constexpr void AddRotationKick(RotationKicks& kicks, Vector2Int offset)
+{
+	for (int i = 0; i < kicks.numOffsets; i++)
+	{
+		if (kicks.offsets[i].x == offset.x && kicks.offsets[i].y == offset.y)
+			return;
+	}
+
+	kicks.offsets[kicks.numOffsets++] = offset;
+}
+
+constexpr RotationKickTable BuildRotationKickTable()
+{
+	RotationKickTable table = RotationKickTable();
+
+	for (int kickClass = 0; kickClass < NUM_KICK_CLASSES; kickClass++)
+	{
+		for (int from = 0; from < NUM_PIECE_ROTATIONS; from++)
+		{
+			for (int to = 0; to < NUM_PIECE_ROTATIONS; to++)
+			{
+				//classic, in place or away from the blocks on either side
+				RotationKicks& classicKicks = table.kicks[ROTATION_CLASSIC][kickClass][from][to];
+				classicKicks.isScaledByBlockedWidth = true;
+
+				AddRotationKick(classicKicks, Vector2Int(0, 0));
+				AddRotationKick(classicKicks, Vector2Int(-1, 0));
+				AddRotationKick(classicKicks, Vector2Int(1, 0));
+
+				//SRS, y is flipped as it goes down on the board
+				RotationKicks& srsKicks = table.kicks[ROTATION_SRS][kickClass][from][to];
+
+				for (int i = 0; i < MAX_ROTATION_KICKS; i++)
+				{
+					int x = (SRS_OFFSETS[kickClass][from][i].x - SRS_OFFSETS[kickClass][to][i].x) - (SRS_OFFSETS[kickClass][from][0].x - SRS_OFFSETS[kickClass][to][0].x);
+					int y = (SRS_OFFSETS[kickClass][from][i].y - SRS_OFFSETS[kickClass][to][i].y) - (SRS_OFFSETS[kickClass][from][0].y - SRS_OFFSETS[kickClass][to][0].y);
+
+					AddRotationKick(srsKicks, Vector2Int(x, -y));
+				}
+
+				//ARS, the I and O pieces don't kick
+				RotationKicks& arsKicks = table.kicks[ROTATION_ARS][kickClass][from][to];
+
+				AddRotationKick(arsKicks, Vector2Int(0, 0));
+
+				if (kickClass == KICK_CLASS_DEFAULT)
+				{
+					AddRotationKick(arsKicks, Vector2Int(1, 0));
+					AddRotationKick(arsKicks, Vector2Int(-1, 0));
+				}
+			}
+		}
+	}
+
+	return table;
+}
+
+//Generated at compile time, finding the kicks of a rotation is a lookup in this table
+inline constexpr RotationKickTable ROTATION_KICKS = BuildRotationKickTable();
+
+static_assert(ROTATION_KICKS.kicks[ROTATION_SRS][KICK_CLASS_DEFAULT][0][1].offsets[2].x == -1 && ROTATION_KICKS.kicks[ROTATION_SRS][KICK_CLASS_DEFAULT][0][1].offsets[2].y == -1, "SRS 0->R should kick up and to the left third");
+static_assert(ROTATION_KICKS.kicks[ROTATION_SRS][KICK_CLASS_I][0][1].offsets[1].x == -2 && ROTATION_KICKS.kicks[ROTATION_SRS][KICK_CLASS_I][0][1].offsets[4].y == -2, "SRS I 0->R should match the guideline table");
+static_assert(ROTATION_KICKS.kicks[ROTATION_SRS][KICK_CLASS_O][0][1].numOffsets == 1, "O pieces should only rotate in place");
+
+/// Kicks to try when rotating a piece of the piece set from one rotation to another
+inline const RotationKicks& GetRotationKicks(RotationSystemType type, const PieceSet& pieceSet, int pieceType, int fromRotation, int toRotation)
+{
+	//custom pieces rotate from their spawn rotation as if it was the SRS spawn state
+	if (!pieceSet.IsStandard())
+		return ROTATION_KICKS.kicks[type][KICK_CLASS_DEFAULT][fromRotation][toRotation];
+
+	int spawnState = MAIN_PIECE_SRS_SPAWN_STATES[pieceType];
+
+	return ROTATION_KICKS.kicks[type][MAIN_PIECE_KICK_CLASSES[pieceType]][(fromRotation + spawnState) % NUM_PIECE_ROTATIONS][(toRotation + spawnState) % NUM_PIECE_ROTATIONS];
+}
+
+/// Rotates a piece of the piece set on the board the way a rotation input does, kicking it to the first offset it fits at.
+/// Moves position by the kick and returns true if the piece could rotate, leaves it alone and returns false otherwise.
+bool KickPieceRotation(const Board& board, RotationSystemType type, const PieceSet& pieceSet, int pieceType, int fromRotation, int toRotation, Vector2Int& position);
\ No newline at end of file
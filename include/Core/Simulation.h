@@ -0,0 +1,208 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "Vector2Int.h"
+#include "Core/Board.h"
+#include "Core/Piece.h"
+#include "Core/PieceMask.h"
+#include "Core/PieceTables.h"
+#include "Core/GameRules.h"
+#include "Core/Random.h"
+#include "Core/Randomizer.h"
+#include "Core/RotationSystem.h"
+#include "Core/Gravity.h"
+#include "Core/Snapshot.h"
+#include "Core/Zobrist.h"
+#include "Core/History.h"
+#include "Core/SimulationInput.h"
+
+//Things that happened during a step, so a front end can react to them (sounds, logging, menus)
+enum SimulationEvent
+{
+	EVENT_NONE = 0,
+	EVENT_PIECE_PLACED = 1 << 0,
+	EVENT_PIECE_HELD = 1 << 1,
+	EVENT_LINES_CLEARED = 1 << 2,
+	EVENT_LEVEL_UP = 1 << 3,
+	EVENT_GAME_OVER = 1 << 4
+};
+
+//A piece as it was placed on the board, along with the lines it completed
+struct PiecePlacement
+{
+	Piece piece;
+	Vector2Int position = Vector2Int{ 0, 0 };
+	int linesCleared = 0;
+};
+
+//Timers count in fractions of a tick, so durations that are shorter than a tick or not a whole number of ticks still add up exactly
+const int64_t TICK_TIME_SCALE = 1 << 16;
+
+//Board, pieces and scoring of a single game, without any dependency on a window, input or audio device
+class Simulation
+{
+	private:
+		GameRules rules;
+
+		Board board;
+
+		Piece currentPiece;
+		PieceMask currentPieceMask; //row masks of currentPiece, for collision checks
+		Vector2Int currentPiecePosition = Vector2Int{ 0, 0 };
+		int64_t gravityPieceCells = 0; //in GRAVITY_CELL_SCALE units
+		int64_t movementPieceTickTime = 0;
+
+		Piece holdingPiece;
+		bool hasSwitchedPiece = false;
+
+		//every game has its own generator, so games can be replayed from their seed and run in parallel
+		uint64_t seed = 0;
+		Random random;
+		std::unique_ptr<Randomizer> randomizer;
+
+		//ring of the next pieces, starting at upAndComingPiecesStart
+		std::vector<int> upAndComingPieceTypes;
+		int upAndComingPiecesStart = 0;
+
+		int64_t lineClearingTickTime = 0;
+		bool isClearingLines = false;
+		int clearingLines[PIECE_MASK_MAX_ROWS]; //a piece can only fill the rows it covers
+		int numClearingLines = 0;
+
+		bool gameOver = false;
+
+		PiecePlacement lastPlacement;
+
+		//statistics
+		int score = 0;
+		int level = 1;
+		int totalLinesCleared = 0;
+		int64_t ticksPlayed = 0;
+
+		//cells per tick of every level for the rules' gravity and tick rate, in GRAVITY_CELL_SCALE units
+		int64_t gravityTable[GRAVITY_TABLE_LEVELS];
+
+		//speeds of the current level, in GRAVITY_CELL_SCALE units per tick
+		int64_t gravityCellsPerTick = 0;
+		int64_t softDropCellsPerTick = 0;
+
+		//durations of the current level, in TICK_TIME_SCALE units
+		int64_t movePieceTickTime = TICK_TIME_SCALE;
+		int64_t lineClearTickTime = TICK_TIME_SCALE;
+
+		//events raised during the current step
+		unsigned int events = EVENT_NONE;
+
+		//placement history, unchanged lines of the board are shared between entries
+		bool recordHistory = false;
+		std::vector<HistoryEntry> history;
+		int historyIndex = 0; //entry the game is at, or history.size() if the game went on after the last entry
+		std::shared_ptr<HistoryLine> historyTopLine; //current lines of the board, shared with the entries
+
+		//Gameplay
+		int64_t SecondsToTickTime(float seconds) const;
+		int64_t CellsPerSecondToCellsPerTick(double cellsPerSecond) const;
+		void UpdateLevelTimings();
+
+		void LineClearCheck(int topY, int bottomY);
+		void EndGame();
+
+		//Snapshots
+		void WriteSnapshotState(SnapshotWriter& writer) const;
+		bool ReadSnapshotState(SnapshotReader& reader);
+
+		//History
+		void RecordHistory();
+		void ClearHistory();
+		void UpdateHistoryLines(int bottomY);
+
+		//Pieces
+		void SetCurrentPiece(const Piece& piece);
+		void SetCurrentPieceRotation(int rotation);
+
+		void NextPiece();
+		void PlacePiece();
+		void HoldPiece();
+		void HardDropPiece();
+
+		void UpdatePieceRotation(const SimulationInput& input);
+		void UpdatePieceMovement(const SimulationInput& input);
+		void UpdatePieceGravity(const SimulationInput& input);
+
+	public:
+		Simulation(GameRules rules);
+
+		/// Changes the rules, resizing the board. Takes effect on the next Start for anything else.
+		void SetRules(GameRules rules);
+		const GameRules& GetRules() const;
+
+		/// Resets the board, pieces and statistics to start a new game, the same seed and rules always give the same pieces
+		void Start(uint64_t seed);
+		uint64_t GetSeed() const;
+
+		/// Advances the game by a single tick of the rules' tick rate using the given input, returns the SimulationEvent flags raised during this tick.
+		/// The game only depends on the inputs of each tick, never on how long a tick took to run.
+		unsigned int Step(const SimulationInput& input);
+
+		/// Appends the whole state of the game to data, rules included. A 10x20 game takes at most a few hundred bytes, reuse data to avoid allocating.
+		void SaveSnapshot(std::vector<uint8_t>& data) const;
+		/// Restores a game saved by SaveSnapshot, along with the rules it was saved with.
+		/// Returns false if the snapshot is invalid or of another version, the game has to be started again then.
+		bool LoadSnapshot(const uint8_t* data, size_t size);
+		/// Hash of the snapshot of the game, games in the same state have the same hash
+		uint64_t GetStateHash() const;
+		/// Zobrist hash of the board, current piece, holding piece and up and coming pieces. Cheap enough to check after every tick,
+		/// the board's part is kept up to date as blocks are placed and lines are cleared.
+		uint64_t GetZobristHash() const;
+
+		/// Starts or stops remembering the game before every placement and hold, for undoing them. Stopping forgets the history.
+		void SetRecordHistory(bool recordHistory);
+		bool IsRecordingHistory() const;
+
+		/// Amount of history entries, the game can go back to any of them and forward again
+		int GetHistorySize() const;
+		/// Entry the game is at, GetHistorySize() if the game went on after the last entry
+		int GetHistoryIndex() const;
+
+		/// Goes back to the game right before the last placement or hold, returns false if there is nothing to undo
+		bool Undo();
+		/// Goes forward to the next entry after an undo, returns false if there is nothing to redo
+		bool Redo();
+		/// Goes to any entry. Placing or holding after going back forgets every entry after the current one.
+		bool SeekHistory(int index);
+
+		const Board& GetBoard() const;
+
+		const Piece& GetCurrentPiece() const;
+		Vector2Int GetCurrentPiecePosition() const;
+		Vector2Int GetDropPosition() const;
+		/// Where new pieces and pieces coming out of hold start, in their spawn or held rotation
+		Vector2Int GetSpawnPosition() const;
+
+		/// Last piece placed, only meant to be read after a step that raised EVENT_PIECE_PLACED
+		const PiecePlacement& GetLastPlacement() const;
+
+		const Piece& GetHoldingPiece() const;
+		bool HasSwitchedPiece() const;
+
+		/// Type of an up and coming piece in the rules' piece set, index 0 is the next piece. The index must be below the rules' NumUpAndComingPieces.
+		int GetUpAndComingPieceType(int index) const;
+
+		bool IsClearingLines() const;
+		float GetLineClearTimeSeconds() const;
+		float GetLineClearingTime() const;
+
+		bool IsGameOver() const;
+		/// True if pieces fall the whole height of the grid in a single tick at the current level, they land in the tick they start falling
+		bool IsGravityInstant() const;
+
+		int GetScore() const;
+		int GetLevel() const;
+		void SetLevel(int level);
+		int GetTotalLinesCleared() const;
+		int64_t GetTicksPlayed() const;
+		float GetTimePlayingSeconds() const;
+};
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+enum SimulationInputAction
+{
+	INPUT_NONE = 0,
+	INPUT_MOVE_LEFT = 1 << 0,
+	INPUT_MOVE_RIGHT = 1 << 1,
+	INPUT_SOFT_DROP = 1 << 2,
+	INPUT_HARD_DROP = 1 << 3,
+	INPUT_ROTATE_CLOCKWISE = 1 << 4,
+	INPUT_ROTATE_COUNTER_CLOCKWISE = 1 << 5,
+	INPUT_ROTATE_HALF_CIRCLE = 1 << 6,
+	INPUT_HOLD = 1 << 7
+};
+
+//Input state for one simulation step, as bit masks of SimulationInputAction
+struct SimulationInput
+{
+	unsigned int down; //actions that are being held down
+	unsigned int pressed; //actions that started being held down since the last step
+
+	SimulationInput(unsigned int down, unsigned int pressed)
+	{
+		this->down = down;
+		this->pressed = pressed;
+	}
+
+	SimulationInput()
+	{
+		down = INPUT_NONE;
+		pressed = INPUT_NONE;
+	}
+
+	bool IsDown(SimulationInputAction action) const
+	{
+		return (down & action) != 0;
+	}
+
+	bool IsPressed(SimulationInputAction action) const
+	{
+		return (pressed & action) != 0;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <string>
+
+//Current version of the snapshot format, bump it whenever the layout of a snapshot changes
+const int SNAPSHOT_VERSION = 4;
+
+//Appends values to a byte buffer in a platform independent format.
+//Unsigned values are written as variable length integers, so small values only take a single byte.
+class SnapshotWriter
+{
+	private:
+		std::vector<uint8_t>& data;
+
+	public:
+		SnapshotWriter(std::vector<uint8_t>& data) : data(data)
+		{
+
+		}
+
+		void WriteByte(uint8_t value);
+		void WriteBool(bool value);
+		void WriteUnsigned(uint64_t value);
+		void WriteSigned(int64_t value);
+		void WriteInt(int value);
+		void WriteUInt32(uint32_t value);
+		void WriteFloat(float value);
+		void WriteString(const std::string& value);
+};
+
+//Reads values written by a SnapshotWriter. Reading past the end or reading a malformed value makes the reader fail,
+//after which every read returns 0. Check IsValid once everything has been read instead of after every read.
+class SnapshotReader
+{
+	private:
+		const uint8_t* data;
+		size_t size;
+		size_t position = 0;
+		bool failed = false;
+
+	public:
+		SnapshotReader(const uint8_t* data, size_t size)
+		{
+			this->data = data;
+			this->size = size;
+		}
+
+		uint8_t ReadByte();
+		bool ReadBool();
+		uint64_t ReadUnsigned();
+		int64_t ReadSigned();
+		uint32_t ReadUInt32();
+		float ReadFloat();
+		std::string ReadString(size_t maxLength);
+
+		/// Reads a signed value that has to be between min and max (both included), the reader fails otherwise
+		int ReadInt(int min, int max);
+
+		/// Makes every following read fail, for values that were read fine but make no sense
+		void Fail();
+
+		bool IsValid() const;
+		bool IsAtEnd() const;
+		/// Bytes read so far, data that follows the snapshot starts there
+		size_t GetPosition() const;
+};
+
+/// 64 bit FNV-1a hash of snapshot data, for comparing states without keeping them around
+uint64_t HashSnapshot(const uint8_t* data, size_t size);
\ No newline at end of file
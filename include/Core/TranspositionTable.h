@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+//Size of a table when none is given, 2^16 entries: several searches of a bot at the default beam width, and small enough to stay in cache
+const size_t DEFAULT_TRANSPOSITION_TABLE_BYTES = 1024 * 1024;
+
+//Entries a position can be stored in, a bucket fills a cache line
+const int TRANSPOSITION_BUCKET_SIZE = 4;
+
+//What the table knows of a position
+struct TranspositionEntry
+{
+	float score = 0.0f;
+	int depth = 0; //placements ahead of the search's game the position was found at, 0-255
+};
+
+//Fixed size table of searched positions, keyed by their hash, shared by every thread of a search without locks.
+//An entry is two 64-bit words, the data and the key xor the data, each written and read atomically. A reader that sees the words
+//of two different writes gets a key that doesn't match and takes it as a miss, so entries are never torn, only lost.
+//Each key has a bucket of entries. A new position replaces the entry of the same key, an empty entry, or else the one from the oldest search,
+//then the one found closest to the game, as positions found further ahead are the ones the next search comes across again.
+class TranspositionTable
+{
+	private:
+		struct TranspositionSlot
+		{
+			std::atomic<uint64_t> check; //key xor data
+			std::atomic<uint64_t> data; //score, depth and search, 0 if empty
+		};
+
+		struct alignas(64) TranspositionBucket
+		{
+			TranspositionSlot slots[TRANSPOSITION_BUCKET_SIZE];
+		};
+
+		//counters are spread over cache lines by key, so threads rarely count on the same line
+		struct alignas(64) TranspositionCounters
+		{
+			std::atomic<uint64_t> numProbes;
+			std::atomic<uint64_t> numHits;
+			std::atomic<uint64_t> numStores;
+			std::atomic<uint64_t> numReplacements; //stores that pushed out another position
+		};
+
+		static const int NUM_COUNTER_SHARDS = 16;
+
+		std::unique_ptr<TranspositionBucket[]> buckets;
+		size_t numBuckets = 0; //a power of two
+		std::atomic<uint8_t> search = 0; //searches started, wrapping around
+
+		TranspositionCounters counters[NUM_COUNTER_SHARDS];
+
+		static uint64_t PackData(const TranspositionEntry& entry, uint8_t entrySearch);
+
+		uint64_t SumCounters(std::atomic<uint64_t> TranspositionCounters::* counter) const;
+
+	public:
+		/// Allocates the largest power of two amount of buckets that fits in sizeBytes, at least one
+		TranspositionTable(size_t sizeBytes = DEFAULT_TRANSPOSITION_TABLE_BYTES);
+
+		TranspositionTable(const TranspositionTable&) = delete;
+		TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+		/// Empties every entry and resets the counters, no thread may use the table meanwhile
+		void Clear();
+
+		/// Ages the entries of earlier searches so they're replaced first, call it before every search. Searches sharing the table age it for each other.
+		void StartSearch();
+
+		/// Looks up the position, returns false if the table doesn't have it
+		bool Probe(uint64_t key, TranspositionEntry& entry);
+		/// Stores the position over whichever entry of its bucket is worth the least
+		void Store(uint64_t key, const TranspositionEntry& entry);
+
+		size_t GetNumEntries() const;
+		size_t GetSizeBytes() const;
+
+		uint64_t GetNumProbes() const;
+		uint64_t GetNumHits() const;
+		uint64_t GetNumStores() const;
+		uint64_t GetNumReplacements() const;
+		/// Hits per probe, 0 if nothing was probed
+		double GetHitRate() const;
+		void ResetCounters();
+};
\ No newline at end of file
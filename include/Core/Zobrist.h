@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+//What a Zobrist key stands for, values of different kinds get unrelated keys
+enum ZobristKeyKind
+{
+	ZOBRIST_CELL,
+	ZOBRIST_LINE,
+	ZOBRIST_CURRENT_PIECE,
+	ZOBRIST_HOLDING_PIECE,
+	ZOBRIST_UP_AND_COMING_PIECE
+};
+
+//Spreads every bit of the value over the whole result (the splitmix64 finalizer)
+inline uint64_t MixZobristBits(uint64_t value)
+{
+	value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+	value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+
+	return value ^ (value >> 31);
+}
+
+//Random key of a value, the same on every platform. Keys are derived from the value instead of looked up in tables,
+//so grids of any height and pieces at any position have one.
+inline uint64_t GetZobristKey(ZobristKeyKind kind, uint64_t value)
+{
+	return MixZobristBits(value + MixZobristBits((uint64_t)kind + 1));
+}
\ No newline at end of file
@@ -1,20 +1,19 @@
 #pragma once
 
 #include "Vector2Int.h"
+#include "Core/GameRules.h"
 
 struct GameOptions
 {
 	bool PlayMusic;
-	int NumUpAndComingPieces;
-	Vector2Int GridSize;
+	GameRules Rules;
 	bool ShowGhostPiece;
 	bool EnableStrobingLights;
 
 	GameOptions(bool playMusic, int numUpAndComingPieces, Vector2Int gridSize, bool showGhostPiece, bool enableStrobingLights)
 	{
 		PlayMusic = playMusic;
-		NumUpAndComingPieces = numUpAndComingPieces;
-		GridSize = gridSize;
+		Rules = GameRules(numUpAndComingPieces, gridSize);
 		ShowGhostPiece = showGhostPiece;
 		EnableStrobingLights = enableStrobingLights;
 	}
@@ -22,8 +21,7 @@ struct GameOptions
 	GameOptions()
 	{
 		PlayMusic = true;
-		NumUpAndComingPieces = 3;
-		GridSize = Vector2Int(10, 20);
+		Rules = GameRules();
 		ShowGhostPiece = true;
 		EnableStrobingLights = true;
 	}
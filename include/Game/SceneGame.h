@@ -2,8 +2,9 @@
 
 #include "raylib-cpp.hpp"
 #include "Scene.h"
-#include "Game/BlockCell.h"
-#include "Game/Piece.h"
+#include "Core/Simulation.h"
+#include "Core/Replay.h"
+#include "Core/Bot.h"
 #include "Game/GameOptions.h"
 #include <iostream>
 
@@ -25,23 +26,26 @@ class SceneGame : public Scene
 
 		GameOptions gameOptions;
 
-		Piece currentPiece;
-		Vector2Int currentPiecePosition = Vector2Int{ 0, 0 };
-		float gravityPieceDeltaTime = 0.0f;
-		float movementPieceDeltaTime = 0.0f;
+		Simulation simulation;
 
-		Piece holdingPiece;
-		bool hasSwitchedPiece = false;
+		//frame time that hasn't been simulated yet, and presses that haven't reached a tick yet
+		float tickAccumulatorSeconds = 0.0f;
+		unsigned int pendingPressedInput = INPUT_NONE;
 
-		std::vector<Piece> bagPieces;
-		std::vector<Piece> upAndComingPieces;
+		//every game is recorded, and saved once it's over
+		ReplayRecorder replayRecorder;
 
-		BlockCell** grid = nullptr;
+		//a replay being watched is played in place of the keyboard
+		bool isWatchingReplay = false;
+		Replay watchedReplay;
+		ReplayPlayer replayPlayer = ReplayPlayer(watchedReplay);
+		bool hasReportedDesync = false;
 
-		float lineClearTimeSeconds = 0.25f;
-		float deltaLineClearingTime = 0.0f;
-		bool isClearingLines = false;
-		std::vector<int> clearingLines;
+		//the bot plays in place of the keyboard when toggled on, and on its own in attract mode after the title menu sits idle
+		Bot bot = Bot(GetBotNumThreads());
+		bool isBotPlaying = false;
+		bool isAttractMode = false;
+		float menuIdleSeconds = 0.0f;
 
 		bool gameOver = false;
 		bool gamePaused = false;
@@ -49,19 +53,15 @@ class SceneGame : public Scene
 		int menuButtonIndex = 0;
 		MenuState menuState = MENU_TITLE;
 
-		//statistics
-		int score = 0;
-		int level = 1;
-		int totalLinesCleared = 0;
-		float timePlayingSeconds = 0;
-
 		//Gameplay
 		void StartGame();
 		void UpdateGameplay();
-		void LineClearCheck(int topY, int bottomY);
 		void UpdateGameOver();
 		void EndGame();
 		void ReturnToMenu();
+		void StartAttractMode();
+
+		static int GetBotNumThreads();
 
 		void DrawGame();
 
@@ -80,45 +80,22 @@ class SceneGame : public Scene
 
 		void DrawBuildInfo();
 
-		//Pieces
-
-		Piece GetRandomPiece();
-		bool CanPieceExistAt(Piece piece, Vector2Int position);
-
-		void RefillBag();
-		Piece GetRandomPieceFromBag();
-
-		void NextPiece();
-		void PlacePiece();
-		void HoldPiece();
-		void HardDropPiece();
-
-		void UpdatePieceRotation();
-		void UpdatePieceMovement();
-		void UpdatePieceGravity();
-
 		//Grid
 
-		bool IsCellInBounds(int x, int y) const;
-		bool IsCellEmpty(int x, int y); 
-
-		void ClearLine(int line);
 		void SetGridSize(Vector2Int size);
-		void DrawGrid(float x, float y, float blockSize, raylib::Texture2D& blockTexture);
+		void DrawGrid(float x, float y, float blockSize, raylib::Texture2D& blockTexture, int firstRow, int numRows);
 
 	public:
-		SceneGame(raylib::Window& window, GameOptions options) : gameWindow(window)
+		SceneGame(raylib::Window& window, GameOptions options) : gameWindow(window), simulation(options.Rules)
 		{
 			gameOptions = options;
-
-			upAndComingPieces.clear();
-			upAndComingPieces.resize(gameOptions.NumUpAndComingPieces);
-
-			SetGridSize(options.GridSize);
 		}
 
 		void Init();
 
+		/// Plays a replay file instead of a game that is played, returns false if it couldn't be loaded
+		bool WatchReplay(const std::string& path);
+
 		void Update();
 		
 		void Draw();
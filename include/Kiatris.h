@@ -19,5 +19,5 @@ const std::string PLATFORM = "Desktop";
 #endif
 
 #ifdef WIN32RELEASE
-int main();
+int main(int argc, char* argv[]);
 #endif
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+struct RectangleInt
+{
+	int x;
+	int y;
+	int width;
+	int height;
+
+	RectangleInt(int X, int Y, int Width, int Height)
+	{
+		x = X;
+		y = Y;
+		width = Width;
+		height = Height;
+	}
+
+	RectangleInt()
+	{
+		x = 0;
+		y = 0;
+		width = 0;
+		height = 0;
+	}
+};
\ No newline at end of file
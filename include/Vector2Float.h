@@ -0,0 +1,19 @@
+#pragma once
+
+struct Vector2Float
+{
+	float x;
+	float y;
+
+	constexpr Vector2Float(float X, float Y)
+	{
+		x = X;
+		y = Y;
+	}
+
+	constexpr Vector2Float()
+	{
+		x = 0.0f;
+		y = 0.0f;
+	}
+};
\ No newline at end of file
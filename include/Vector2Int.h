@@ -5,13 +5,13 @@ struct Vector2Int
 	int x;
 	int y;
 
-	Vector2Int(int X, int Y)
+	constexpr Vector2Int(int X, int Y)
 	{
 		x = X;
 		y = Y;
 	}
 
-	Vector2Int()
+	constexpr Vector2Int()
 	{
 		x = 0;
 		y = 0;
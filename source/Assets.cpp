@@ -1,9 +1,19 @@
+#include <iostream>
+
 #include "Assets.h"
 
+//piece set files, loaded in this order after the standard set
+const char* PIECE_SET_FILES[] =
+{
+	"assets/pieces/trominoes.txt",
+	"assets/pieces/pentominoes.txt"
+};
+
 std::unordered_map<std::string, raylib::Texture2D> textures;
 std::unordered_map<std::string, raylib::Sound> sounds;
 std::unordered_map<std::string, raylib::Music> musicFiles;
 std::unordered_map<std::string, raylib::Font> fonts;
+std::vector<std::shared_ptr<const PieceSet>> pieceSets;
 
 void LoadAssets()
 {
@@ -32,6 +42,20 @@ void LoadAssets()
 
 	//fonts
 	fonts.emplace("MainFont", raylib::Font());
+
+	//piece sets, a broken file only leaves out its set
+	pieceSets.push_back(PieceSet::GetStandard());
+
+	for (const char* path : PIECE_SET_FILES)
+	{
+		std::string error;
+		std::shared_ptr<PieceSet> pieceSet = PieceSet::LoadFromFile(path, error);
+
+		if (pieceSet != nullptr)
+			pieceSets.push_back(pieceSet);
+		else
+			std::cout << "Failed to load piece set: " << error << std::endl;
+	}
 }
 
 void UnloadAssets()
@@ -62,6 +86,8 @@ void UnloadAssets()
 
 	sounds.clear();
 
+	pieceSets.clear();
+
 	//music is automatically unloaded
 }
 
@@ -83,4 +109,9 @@ raylib::Music& GetMusic(std::string name)
 raylib::Font& GetFont(std::string name)
 {
 	return fonts.at(name);
+}
+
+const std::vector<std::shared_ptr<const PieceSet>>& GetPieceSets()
+{
+	return pieceSets;
 }
\ No newline at end of file
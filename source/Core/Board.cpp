@@ -0,0 +1,575 @@
+#include <algorithm>
+
+#include "Core/Board.h"
+
+void Board::DeleteGrid()
+{
+	for (int i = 0; i < chunkCapacity; i++)
+	{
+		if (cellChunks[i] != emptyChunk)
+			delete[] cellChunks[i];
+	}
+
+	delete[] cellChunks;
+	cellChunks = nullptr;
+	numChunks = 0;
+	chunkCapacity = 0;
+
+	delete[] emptyChunk;
+	emptyChunk = nullptr;
+	chunkNumCells = 0;
+
+	delete[] rowMasks;
+	rowMasks = nullptr;
+
+	delete[] rowHashes;
+	rowHashes = nullptr;
+
+	delete[] rowTable;
+	rowTable = nullptr;
+	rowCapacity = 0;
+
+	delete[] columnTops;
+	columnTops = nullptr;
+	columnCapacity = 0;
+}
+
+//Allocates the chunk of the storage row if it still is the shared empty chunk
+BlockCell* Board::GetWritableStorageRowCells(int storageRow)
+{
+	BlockCell*& chunk = cellChunks[storageRow >> chunkRowsShift];
+
+	if (chunk == emptyChunk)
+	{
+		chunk = new BlockCell[chunkNumCells];
+		std::copy(emptyChunk, emptyChunk + chunkNumCells, chunk);
+	}
+
+	return chunk + BOARD_GUARD_SIZE + (storageRow & ((1 << chunkRowsShift) - 1)) * rowStride;
+}
+
+void Board::ClearStorageRow(int storageRow)
+{
+	rowMasks[storageRow] = 0;
+	rowHashes[storageRow] = 0;
+
+	//rows in the empty chunk are already empty
+	if (cellChunks[storageRow >> chunkRowsShift] == emptyChunk)
+		return;
+
+	BlockCell* row = GetWritableStorageRowCells(storageRow);
+
+	for (int x = 0; x < size.x; x++)
+		row[x] = BlockCell(BLOCK_EMPTY, PALETTE_BLANK);
+}
+
+int Board::FindColumnTop(int x, int fromY) const
+{
+	for (int y = fromY; y < size.y; y++)
+	{
+		if ((rowMasks[GetStorageRow(y)] & (1u << x)) != 0)
+			return y;
+	}
+
+	return size.y;
+}
+
+//y of the highest non-empty cell, size.y if the board is empty
+int Board::GetStackTop() const
+{
+	int top = size.y;
+
+	for (int x = 0; x < size.x; x++)
+		top = std::min(top, columnTops[x]);
+
+	return top;
+}
+
+uint64_t Board::GetCellKey(int x, BlockCell cell)
+{
+	if (cell.state == BLOCK_EMPTY)
+		return 0;
+
+	return GetZobristKey(ZOBRIST_CELL, ((uint64_t)x << 8) | (uint64_t)(cell.state | (cell.colorIndex << 2)));
+}
+
+void Board::UpdateCellHash(int y, int storageRow, uint64_t keyChange)
+{
+	hash ^= GetLineHash(y);
+	rowHashes[storageRow] ^= keyChange;
+	hash ^= GetLineHash(y);
+}
+
+//Only allocates if the new size does not fit in the memory of the previous sizes, grid cells are allocated once blocks are placed in them
+void Board::SetSize(Vector2Int gridSize)
+{
+	size = gridSize;
+	fullRowMask = (1u << gridSize.x) - 1u;
+
+	//grid rows + ceiling row + floor row
+	int numStorageRows = gridSize.y + 2;
+
+	//chunks are a power of two rows, small grids fit in a single chunk
+	int newChunkRowsShift = 0;
+
+	while ((1 << newChunkRowsShift) < std::min(numStorageRows, BOARD_MAX_CHUNK_ROWS))
+		newChunkRowsShift++;
+
+	int newRowStride = BOARD_GUARD_SIZE + gridSize.x;
+	int newChunkNumCells = BOARD_GUARD_SIZE + (1 << newChunkRowsShift) * newRowStride;
+	int newNumChunks = ((numStorageRows - 1) >> newChunkRowsShift) + 1;
+
+	//chunks of a different layout can not be reused
+	if (newChunkNumCells != chunkNumCells || newRowStride != rowStride)
+	{
+		for (int i = 0; i < chunkCapacity; i++)
+		{
+			if (cellChunks[i] != emptyChunk)
+				delete[] cellChunks[i];
+		}
+
+		delete[] emptyChunk;
+
+		chunkNumCells = newChunkNumCells;
+		rowStride = newRowStride;
+		chunkRowsShift = newChunkRowsShift;
+		emptyChunk = new BlockCell[chunkNumCells];
+
+		//walls everywhere except for the cells of the rows
+		for (int i = 0; i < chunkNumCells; i++)
+			emptyChunk[i] = BlockCell(BLOCK_GRID, PALETTE_BLANK);
+
+		for (int row = 0; row < (1 << chunkRowsShift); row++)
+		{
+			for (int x = 0; x < gridSize.x; x++)
+				emptyChunk[BOARD_GUARD_SIZE + row * rowStride + x] = BlockCell(BLOCK_EMPTY, PALETTE_BLANK);
+		}
+
+		for (int i = 0; i < chunkCapacity; i++)
+			cellChunks[i] = emptyChunk;
+	}
+
+	if (newNumChunks > chunkCapacity)
+	{
+		BlockCell** newCellChunks = new BlockCell*[newNumChunks];
+
+		for (int i = 0; i < newNumChunks; i++)
+			newCellChunks[i] = (i < chunkCapacity) ? cellChunks[i] : emptyChunk;
+
+		delete[] cellChunks;
+		cellChunks = newCellChunks;
+		chunkCapacity = newNumChunks;
+	}
+
+	numChunks = newNumChunks;
+
+	if (numStorageRows + 2 * BOARD_GUARD_SIZE > rowCapacity)
+	{
+		delete[] rowMasks;
+		delete[] rowHashes;
+		delete[] rowTable;
+
+		rowCapacity = numStorageRows + 2 * BOARD_GUARD_SIZE;
+		rowMasks = new uint32_t[rowCapacity];
+		rowHashes = new uint64_t[rowCapacity];
+		rowTable = new int[rowCapacity];
+	}
+
+	if (gridSize.x > columnCapacity)
+	{
+		delete[] columnTops;
+		columnTops = new int[gridSize.x];
+		columnCapacity = gridSize.x;
+	}
+
+	if (gridSize.x == 10 && gridSize.y == 20)
+		sizeClass = BOARD_SIZE_10X20;
+	else if (gridSize.x == 10 && gridSize.y == 40)
+		sizeClass = BOARD_SIZE_10X40;
+	else
+		sizeClass = BOARD_SIZE_CUSTOM;
+
+	Clear();
+}
+
+Vector2Int Board::GetSize() const
+{
+	return size;
+}
+
+void Board::Clear()
+{
+	int ceilingRow = size.y;
+	int floorRow = size.y + 1;
+
+	//chunks that were written to are reset to the empty chunk's contents, but stay allocated
+	for (int i = 0; i < chunkCapacity; i++)
+	{
+		if (cellChunks[i] != emptyChunk)
+			std::copy(emptyChunk, emptyChunk + chunkNumCells, cellChunks[i]);
+	}
+
+	for (int y = 0; y < size.y; y++)
+	{
+		rowTable[BOARD_GUARD_SIZE + y] = y;
+		rowMasks[y] = 0;
+		rowHashes[y] = 0;
+	}
+
+	rowMasks[ceilingRow] = 0;
+	rowHashes[ceilingRow] = 0;
+	rowHashes[floorRow] = 0;
+	hash = 0;
+
+	//the floor is a wall
+	BlockCell* floorCells = GetWritableStorageRowCells(floorRow);
+
+	for (int x = 0; x < size.x; x++)
+		floorCells[x] = BlockCell(BLOCK_GRID, PALETTE_BLANK);
+
+	rowMasks[floorRow] = fullRowMask;
+
+	for (int i = 0; i < BOARD_GUARD_SIZE; i++)
+	{
+		rowTable[i] = ceilingRow;
+		rowTable[BOARD_GUARD_SIZE + size.y + i] = floorRow;
+	}
+
+	for (int x = 0; x < size.x; x++)
+		columnTops[x] = size.y;
+}
+
+bool Board::IsCellInBounds(int x, int y) const
+{
+	return x >= 0 && x < size.x && y >= 0 && y < size.y;
+}
+
+//Out of bounds cells do not count as empty and thus return false, unless this cell is above the grid but still within the left and right bounds.
+//The cell can be at most BOARD_GUARD_SIZE cells outside of the grid, those are read from the guard band.
+bool Board::IsCellEmpty(int x, int y) const
+{
+	return GetStorageRowCells(GetStorageRow(y))[x].state == BLOCK_EMPTY;
+}
+
+const BlockCell& Board::GetCell(int x, int y) const
+{
+	return GetStorageRowCells(GetStorageRow(y))[x];
+}
+
+void Board::SetCell(int x, int y, BlockCell cell)
+{
+	int storageRow = GetStorageRow(y);
+	BlockCell& gridCell = GetWritableStorageRowCells(storageRow)[x];
+
+	UpdateCellHash(y, storageRow, GetCellKey(x, gridCell) ^ GetCellKey(x, cell));
+	gridCell = cell;
+
+	if (cell.state == BLOCK_EMPTY)
+	{
+		rowMasks[storageRow] &= ~(1u << x);
+
+		if (y == columnTops[x])
+			columnTops[x] = FindColumnTop(x, y + 1);
+	}
+	else
+	{
+		rowMasks[storageRow] |= 1u << x;
+		columnTops[x] = std::min(columnTops[x], y);
+	}
+}
+
+void Board::SetCellState(int x, int y, BlockCellState state)
+{
+	int storageRow = GetStorageRow(y);
+	BlockCell& gridCell = GetWritableStorageRowCells(storageRow)[x];
+	uint64_t oldKey = GetCellKey(x, gridCell);
+
+	gridCell.state = state;
+	UpdateCellHash(y, storageRow, oldKey ^ GetCellKey(x, gridCell));
+
+	if (state == BLOCK_EMPTY)
+	{
+		rowMasks[storageRow] &= ~(1u << x);
+
+		if (y == columnTops[x])
+			columnTops[x] = FindColumnTop(x, y + 1);
+	}
+	else
+	{
+		rowMasks[storageRow] |= 1u << x;
+		columnTops[x] = std::min(columnTops[x], y);
+	}
+}
+
+uint32_t Board::GetRowMask(int y) const
+{
+	return rowMasks[GetStorageRow(y)];
+}
+
+uint32_t Board::GetFullRowMask() const
+{
+	return fullRowMask;
+}
+
+int Board::GetColumnTop(int x) const
+{
+	return columnTops[x];
+}
+
+int Board::GetColumnHeight(int x) const
+{
+	return size.y - columnTops[x];
+}
+
+//Clearing blocks count as filled, only call this for lines that aren't already being cleared
+bool Board::IsLineFull(int y) const
+{
+	return rowMasks[GetStorageRow(y)] == fullRowMask;
+}
+
+//Moves every line above the cleared line down by one, the cleared row becomes the empty top line.
+//Only row table entries move, the cells of the other lines stay where they are.
+void Board::ClearLine(int line)
+{
+	int* lines = rowTable + BOARD_GUARD_SIZE;
+	int clearedRow = lines[line];
+
+	//only the lines from the top of the stack down to the cleared line change, the lines above it are empty
+	int stackTop = GetStackTop();
+
+	for (int y = stackTop; y <= line; y++)
+		hash ^= GetLineHash(y);
+
+	std::copy_backward(lines, lines + line, lines + line + 1);
+	lines[0] = clearedRow;
+
+	ClearStorageRow(clearedRow);
+
+	for (int y = stackTop; y <= line; y++)
+		hash ^= GetLineHash(y);
+
+	//blocks above the line moved down, columns whose highest block was on the line now start at the next block below it
+	for (int x = 0; x < size.x; x++)
+	{
+		if (columnTops[x] < line)
+			columnTops[x]++;
+		else if (columnTops[x] == line)
+			columnTops[x] = FindColumnTop(x, line + 1);
+	}
+}
+
+//Pushes every line up by one and fills the new bottom line with blocks, except for the hole.
+//Returns true if any blocks were pushed off the top of the grid.
+bool Board::InsertGarbageLine(int holeX, unsigned char colorIndex)
+{
+	int* lines = rowTable + BOARD_GUARD_SIZE;
+	int topRow = lines[0];
+	bool overflowed = rowMasks[topRow] != 0;
+
+	int stackTop = GetStackTop();
+
+	for (int y = stackTop; y < size.y; y++)
+		hash ^= GetLineHash(y);
+
+	//the top row becomes the bottom line
+	std::copy(lines + 1, lines + size.y, lines);
+	lines[size.y - 1] = topRow;
+
+	BlockCell* row = GetWritableStorageRowCells(topRow);
+
+	for (int x = 0; x < size.x; x++)
+	{
+		if (x == holeX)
+			row[x] = BlockCell(BLOCK_EMPTY, PALETTE_BLANK);
+		else
+			row[x] = BlockCell(BLOCK_GRID, colorIndex);
+	}
+
+	rowMasks[topRow] = fullRowMask & ~(1u << holeX);
+	rowHashes[topRow] = 0;
+
+	for (int x = 0; x < size.x; x++)
+		rowHashes[topRow] ^= GetCellKey(x, row[x]);
+
+	for (int y = std::max(stackTop - 1, 0); y < size.y; y++)
+		hash ^= GetLineHash(y);
+
+	for (int x = 0; x < size.x; x++)
+	{
+		if (columnTops[x] == size.y)
+			columnTops[x] = (x == holeX) ? size.y : size.y - 1;
+		else if (columnTops[x] > 0)
+			columnTops[x]--;
+		else
+			columnTops[x] = FindColumnTop(x, 0);
+	}
+
+	return overflowed;
+}
+
+uint64_t Board::GetHash() const
+{
+	return hash;
+}
+
+bool Board::CanPieceExistAt(const Piece& piece, Vector2Int position) const
+{
+	return CanPieceExistAt(PieceMask::FromPiece(piece), position);
+}
+
+uint64_t Board::GetPaddedRowMask(int y) const
+{
+	//below the grid is all floor
+	if (y >= size.y)
+		return ~(uint64_t)0;
+
+	uint64_t walls = ~((uint64_t)fullRowMask << BOARD_KICK_PADDING);
+
+	//above the grid is empty between the walls
+	if (y < 0)
+		return walls;
+
+	return walls | ((uint64_t)rowMasks[GetStorageRow(y)] << BOARD_KICK_PADDING);
+}
+
+int Board::FindFittingOffset(const PieceMask& pieceMask, Vector2Int position, const Vector2Int* offsets, int numOffsets) const
+{
+	if (numOffsets == 0)
+		return -1;
+
+	//a piece without blocks fits anywhere
+	if (pieceMask.height == 0)
+		return 0;
+
+	int minOffsetY = offsets[0].y;
+	int maxOffsetY = offsets[0].y;
+
+	for (int i = 1; i < numOffsets; i++)
+	{
+		minOffsetY = std::min(minOffsetY, offsets[i].y);
+		maxOffsetY = std::max(maxOffsetY, offsets[i].y);
+	}
+
+	int firstLine = position.y + pieceMask.top + minOffsetY;
+	int numLines = pieceMask.height + maxOffsetY - minOffsetY;
+
+	if (numLines > BOARD_MAX_KICK_LINES)
+	{
+		for (int i = 0; i < numOffsets; i++)
+		{
+			if (CanPieceExistAt(pieceMask, Vector2Int{ position.x + offsets[i].x, position.y + offsets[i].y }))
+				return i;
+		}
+
+		return -1;
+	}
+
+	//every line any of the offsets covers, walls and floor included
+	uint64_t lineMasks[BOARD_MAX_KICK_LINES];
+
+	for (int i = 0; i < numLines; i++)
+		lineMasks[i] = GetPaddedRowMask(firstLine + i);
+
+	for (int i = 0; i < numOffsets; i++)
+	{
+		int paddedLeft = position.x + offsets[i].x + pieceMask.left + BOARD_KICK_PADDING;
+
+		//further out than the walls reach, which is out of bounds either way
+		if (paddedLeft < 0 || paddedLeft + pieceMask.width > 64)
+			continue;
+
+		const uint64_t* offsetLineMasks = lineMasks + offsets[i].y - minOffsetY;
+		uint64_t overlap = 0;
+
+		for (int row = 0; row < pieceMask.height; row++)
+			overlap |= offsetLineMasks[row] & ((uint64_t)pieceMask.rows[row] << paddedLeft);
+
+		if (overlap == 0)
+			return i;
+	}
+
+	return -1;
+}
+
+uint32_t Board::GetBlockedColumns(const PieceMask& pieceMask, Vector2Int position) const
+{
+	int paddedLeft = position.x + pieceMask.left + BOARD_KICK_PADDING;
+	int top = position.y + pieceMask.top;
+
+	//further out than the walls reach, every column is blocked
+	bool isPastWalls = paddedLeft < 0 || paddedLeft + pieceMask.width > 64;
+
+	uint32_t blockedColumns = 0;
+
+	for (int row = 0; row < pieceMask.height; row++)
+	{
+		if (isPastWalls)
+			blockedColumns |= pieceMask.rows[row];
+		else
+			blockedColumns |= (uint32_t)((GetPaddedRowMask(top + row) >> paddedLeft) & pieceMask.rows[row]);
+	}
+
+	return blockedColumns;
+}
+
+void Board::WriteSnapshot(SnapshotWriter& writer) const
+{
+	int firstLine = size.y;
+
+	for (int x = 0; x < size.x; x++)
+		firstLine = std::min(firstLine, columnTops[x]);
+
+	writer.WriteInt(firstLine);
+
+	//the mask of each line, followed by the state and color of every block in it
+	for (int y = firstLine; y < size.y; y++)
+	{
+		uint32_t rowMask = GetRowMask(y);
+		const BlockCell* row = GetStorageRowCells(GetStorageRow(y));
+
+		writer.WriteUnsigned(rowMask);
+
+		for (int x = 0; x < size.x; x++)
+		{
+			if ((rowMask & (1u << x)) != 0)
+				writer.WriteByte((uint8_t)(row[x].state | (row[x].colorIndex << 2)));
+		}
+	}
+}
+
+bool Board::ReadSnapshot(SnapshotReader& reader)
+{
+	Clear();
+
+	int firstLine = reader.ReadInt(0, size.y);
+
+	for (int y = firstLine; y < size.y && reader.IsValid(); y++)
+	{
+		uint64_t rowMask = reader.ReadUnsigned();
+
+		if ((rowMask & ~(uint64_t)fullRowMask) != 0)
+			reader.Fail();
+
+		for (int x = 0; x < size.x && reader.IsValid(); x++)
+		{
+			if ((rowMask & (1u << x)) == 0)
+				continue;
+
+			uint8_t cellByte = reader.ReadByte();
+			BlockCellState state = (BlockCellState)(cellByte & 3);
+
+			if (state != BLOCK_GRID && state != BLOCK_CLEARING)
+				reader.Fail();
+
+			SetCell(x, y, BlockCell(state, (unsigned char)(cellByte >> 2)));
+		}
+	}
+
+	if (!reader.IsValid())
+	{
+		Clear();
+		return false;
+	}
+
+	return true;
+}
\ No newline at end of file
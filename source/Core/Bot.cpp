@@ -0,0 +1,750 @@
+#include <algorithm>
+#include <bit>
+
+#include "Core/Bot.h"
+
+//El-Tetris weights, found by Islam El-Ashi with particle swarm optimization
+const float BOT_LANDING_HEIGHT_WEIGHT = -4.500158825082766f;
+const float BOT_LINES_CLEARED_WEIGHT = 3.4181268101392694f;
+const float BOT_ROW_TRANSITIONS_WEIGHT = -3.2178882868487753f;
+const float BOT_COLUMN_TRANSITIONS_WEIGHT = -9.348695305445199f;
+const float BOT_HOLES_WEIGHT = -7.899265427351652f;
+const float BOT_WELLS_WEIGHT = -3.3855972247263626f;
+
+Bot::Bot(int numThreads)
+{
+	numThreads = std::max(numThreads, 1);
+
+	for (int i = 0; i < numThreads; i++)
+		workers.push_back(std::make_unique<BotWorker>());
+
+	for (int i = 1; i < numThreads; i++)
+		threads.emplace_back(&Bot::RunThread, this, i);
+}
+
+Bot::~Bot()
+{
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		isStopping = true;
+	}
+
+	jobCondition.notify_all();
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+#pragma region Thread pool
+
+void Bot::RunThread(int workerIndex)
+{
+	uint64_t lastJobNumber = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(jobMutex);
+			jobCondition.wait(lock, [&]() { return isStopping || jobNumber != lastJobNumber; });
+
+			if (isStopping)
+				return;
+
+			lastJobNumber = jobNumber;
+		}
+
+		RunJob(*workers[workerIndex]);
+
+		{
+			std::lock_guard<std::mutex> lock(jobMutex);
+			numThreadsDone++;
+		}
+
+		doneCondition.notify_one();
+	}
+}
+
+void Bot::RunJob(BotWorker& worker)
+{
+	//every thread takes the next node that hasn't been taken, until they're all expanded or time is up
+	while (true)
+	{
+		int nodeIndex = nextJobNode.fetch_add(1);
+
+		if (nodeIndex >= (int)beam.size())
+			return;
+
+		if (hasDeadline && std::chrono::steady_clock::now() >= deadline)
+		{
+			isOutOfTime = true;
+			return;
+		}
+
+		ExpandNode(worker, nodeIndex);
+	}
+}
+
+void Bot::ExpandBeam(bool isTimed)
+{
+	children.resize(beam.size());
+
+	for (size_t i = 0; i < beam.size(); i++)
+		children[i].clear();
+
+	nextJobNode = 0;
+	isOutOfTime = false;
+	hasDeadline = isTimed;
+
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		jobNumber++;
+		numThreadsDone = 0;
+	}
+
+	jobCondition.notify_all();
+
+	RunJob(*workers[0]);
+
+	std::unique_lock<std::mutex> lock(jobMutex);
+	doneCondition.wait(lock, [&]() { return numThreadsDone == (int)threads.size(); });
+}
+
+#pragma endregion
+
+#pragma region Search
+
+void Bot::ExpandNode(BotWorker& worker, int nodeIndex)
+{
+	const BotNode& node = beam[nodeIndex];
+	const uint32_t* lines = beamLines.data() + node.linesStart;
+	int numLines = rules.GridSize.y - node.stackTop;
+
+	//nodes that can't go any further still compete with the nodes that can
+	if (node.currentType < 0 || node.isGameOver)
+	{
+		children[nodeIndex].push_back(node);
+		children[nodeIndex].back().parentIndex = nodeIndex;
+		children[nodeIndex].back().placedType = -1;
+
+		return;
+	}
+
+	Board& board = worker.board;
+	board.Clear();
+
+	for (int i = 0; i < numLines; i++)
+	{
+		uint32_t line = lines[i];
+
+		while (line != 0)
+		{
+			board.SetCell(std::countr_zero(line), node.stackTop + i, BlockCell(BLOCK_GRID, PALETTE_BLANK));
+			line &= line - 1;
+		}
+	}
+
+	MoveGenerator& moveGenerator = worker.moveGenerator;
+
+	//placing the current piece
+	Piece piece = rules.Pieces->GetPiece(node.currentType);
+	piece.rotation = node.currentRotation;
+
+	moveGenerator.Generate(board, rules.RotationSystem, *rules.Pieces, piece, node.currentPosition, isGravityInstant);
+
+	for (int i = 0; i < moveGenerator.GetNumPlacements(); i++)
+	{
+		BotNode placing = node;
+
+		if (isExpandingRoot)
+		{
+			placing.firstChoice = (int)firstChoices.size();
+			firstChoices.push_back(BotDecision{ false, moveGenerator.GetPlacement(i) });
+		}
+
+		AddChild(worker, nodeIndex, placing, node.currentType, moveGenerator.GetPlacement(i));
+	}
+
+	//holding it and placing the piece that comes out of hold, or the next piece if nothing was held
+	if (!node.canHold)
+		return;
+
+	BotNode placing = node;
+	placing.holdingType = node.currentType;
+	placing.holdingRotation = node.currentRotation;
+
+	if (node.holdingType >= 0)
+	{
+		piece = rules.Pieces->GetPiece(node.holdingType);
+		piece.rotation = node.holdingRotation;
+	}
+	else if (node.nextPieceIndex < (int)upAndComingPieceTypes.size())
+	{
+		piece = rules.Pieces->GetPiece(upAndComingPieceTypes[node.nextPieceIndex]);
+		placing.nextPieceIndex++;
+	}
+	else
+		return;
+
+	//the game ends if the piece coming out can't be where it spawns
+	Vector2Int spawnPosition = Vector2Int{ rules.GridSize.x / 2, 0 };
+
+	if (!board.CanPieceExistAt(rules.Pieces->GetShape(piece.type, piece.rotation).mask, spawnPosition))
+		return;
+
+	moveGenerator.Generate(board, rules.RotationSystem, *rules.Pieces, piece, spawnPosition, isGravityInstant);
+
+	if (isExpandingRoot && moveGenerator.GetNumPlacements() > 0)
+	{
+		placing.firstChoice = (int)firstChoices.size();
+		firstChoices.push_back(BotDecision{ true, MovePlacement() });
+	}
+
+	for (int i = 0; i < moveGenerator.GetNumPlacements(); i++)
+		AddChild(worker, nodeIndex, placing, piece.type, moveGenerator.GetPlacement(i));
+}
+
+int Bot::PlaceLines(const BotNode& parent, int type, const MovePlacement& placement, std::vector<uint32_t>& lines, int& stackTop) const
+{
+	const PieceMask& mask = rules.Pieces->GetShape(type, placement.rotation).mask;
+	const uint32_t* parentLines = beamLines.data() + parent.linesStart;
+
+	int height = rules.GridSize.y;
+	uint32_t fullLineMask = ((uint64_t)1 << rules.GridSize.x) - 1;
+
+	//lines from the top of the stack or the piece down, blocks above the grid are left out like when the game places them
+	int pieceTop = placement.position.y + mask.top;
+	int top = std::clamp(std::min(parent.stackTop, pieceTop), 0, height);
+	int numLines = height - top;
+
+	lines.resize(numLines);
+
+	for (int y = top; y < height; y++)
+		lines[y - top] = (y < parent.stackTop) ? 0 : parentLines[y - parent.stackTop];
+
+	for (int row = 0; row < mask.height; row++)
+	{
+		int y = pieceTop + row;
+
+		if (y >= 0 && y < height)
+			lines[y - top] |= mask.rows[row] << (placement.position.x + mask.left);
+	}
+
+	//full lines are cleared, the lines above them move down
+	int numClearedLines = 0;
+	int writeIndex = numLines - 1;
+
+	for (int readIndex = numLines - 1; readIndex >= 0; readIndex--)
+	{
+		if (lines[readIndex] == fullLineMask)
+			numClearedLines++;
+		else
+			lines[writeIndex--] = lines[readIndex];
+	}
+
+	int firstLine = numClearedLines;
+
+	while (firstLine < numLines && lines[firstLine] == 0)
+		firstLine++;
+
+	lines.erase(lines.begin(), lines.begin() + firstLine);
+	stackTop = top + firstLine;
+
+	return numClearedLines;
+}
+
+void Bot::AddChild(BotWorker& worker, int nodeIndex, const BotNode& placing, int type, const MovePlacement& placement)
+{
+	const BotNode& parent = beam[nodeIndex];
+	const uint32_t* parentLines = beamLines.data() + parent.linesStart;
+	const PieceMask& mask = rules.Pieces->GetShape(type, placement.rotation).mask;
+
+	int height = rules.GridSize.y;
+	uint32_t fullLineMask = ((uint64_t)1 << rules.GridSize.x) - 1;
+
+	int pieceTop = placement.position.y + mask.top;
+	int pieceLeft = placement.position.x + mask.left;
+
+	//line of the board after the piece is placed, before any are cleared
+	auto getPlacedLine = [&](int y)
+	{
+		uint32_t line = (y >= parent.stackTop) ? parentLines[y - parent.stackTop] : 0;
+		int row = y - pieceTop;
+
+		if (row >= 0 && row < mask.height)
+			line |= mask.rows[row] << pieceLeft;
+
+		return line;
+	};
+
+	BotNode child = placing;
+	child.parentIndex = nodeIndex;
+	child.placedType = type;
+	child.placement = placement;
+	child.canHold = true;
+
+	//the next piece comes up, the game ends if it can't spawn. It spawns before the lines are cleared.
+	if (child.nextPieceIndex < (int)upAndComingPieceTypes.size())
+	{
+		child.currentType = upAndComingPieceTypes[child.nextPieceIndex];
+		child.nextPieceIndex++;
+	}
+	else
+		child.currentType = -1;
+
+	child.currentRotation = 0;
+	child.currentPosition = Vector2Int{ rules.GridSize.x / 2, 0 };
+
+	if (child.currentType >= 0)
+	{
+		const PieceMask& nextMask = rules.Pieces->GetShape(child.currentType, 0).mask;
+
+		for (int row = 0; row < nextMask.height; row++)
+		{
+			int y = child.currentPosition.y + nextMask.top + row;
+
+			if (y >= 0 && y < height && (getPlacedLine(y) & (nextMask.rows[row] << (child.currentPosition.x + nextMask.left))) != 0)
+			{
+				child.isGameOver = true;
+				break;
+			}
+		}
+	}
+
+	//only the lines the piece lands in change, unless they're cleared
+	bool isClearingLines = false;
+	child.stackTop = parent.stackTop;
+	child.linesHash = parent.linesHash;
+
+	for (int row = 0; row < mask.height; row++)
+	{
+		int y = pieceTop + row;
+
+		if (y < 0 || y >= height || mask.rows[row] == 0)
+			continue;
+
+		uint32_t line = (y >= parent.stackTop) ? parentLines[y - parent.stackTop] : 0;
+		uint32_t placedLine = getPlacedLine(y);
+
+		child.linesHash ^= GetLineKey(y, line) ^ GetLineKey(y, placedLine);
+		child.stackTop = std::min(child.stackTop, y);
+		isClearingLines |= placedLine == fullLineMask;
+	}
+
+	//clearing lines moves the lines above them, so those boards are built in full
+	std::vector<uint32_t>& lines = worker.lines;
+	bool hasLines = false;
+	int numClearedLines = 0;
+
+	if (isClearingLines)
+	{
+		numClearedLines = PlaceLines(parent, type, placement, lines, child.stackTop);
+		child.linesHash = HashLines(lines.data(), child.stackTop);
+		hasLines = true;
+	}
+
+	float landingHeight = (float)(height - pieceTop) - (float)mask.height / 2.0f;
+	child.reward = placing.reward + landingHeight * BOT_LANDING_HEIGHT_WEIGHT + (float)numClearedLines * BOT_LINES_CLEARED_WEIGHT;
+	child.hash = HashNode(child);
+
+	//positions reached through placements in another order are only built and evaluated by whichever thread comes across them first,
+	//the lines of a child are only kept if it makes it into the beam
+	if (child.isGameOver)
+		child.score = BOT_GAME_OVER_SCORE;
+	else
+	{
+		TranspositionEntry entry = TranspositionEntry();
+
+		if (transpositionTable == nullptr || !transpositionTable->Probe(child.hash, entry))
+		{
+			if (!hasLines)
+				PlaceLines(parent, type, placement, lines, child.stackTop);
+
+			entry.score = ScoreLines(lines.data(), (int)lines.size());
+			entry.depth = expandingDepth;
+
+			if (transpositionTable != nullptr)
+				transpositionTable->Store(child.hash, entry);
+		}
+
+		child.score = child.reward + entry.score;
+	}
+
+	children[nodeIndex].push_back(child);
+}
+
+float Bot::ScoreLines(const uint32_t* lines, int numLines) const
+{
+	int width = rules.GridSize.x;
+	uint32_t fullLineMask = ((uint64_t)1 << width) - 1;
+
+	//empty lines go from the left wall to the right wall and back
+	int rowTransitions = 2 * (rules.GridSize.y - numLines);
+	int columnTransitions = 0;
+	int holes = 0;
+	int wells = 0;
+
+	//depth of the well each column is in, the well sums count 1 + 2 + ... + depth for every well
+	int wellDepths[32] = {};
+	uint32_t previousWells = 0;
+
+	uint32_t previousLine = 0;
+	uint32_t coveredColumns = 0;
+
+	for (int i = 0; i < numLines; i++)
+	{
+		uint32_t line = lines[i];
+
+		//walls count as blocks on either side
+		uint64_t leftNeighbors = ((uint64_t)line << 1) | 1;
+		uint64_t rightNeighbors = ((uint64_t)line >> 1) | ((uint64_t)1 << (width - 1));
+
+		rowTransitions += std::popcount((((uint64_t)line | ((uint64_t)1 << width)) ^ leftNeighbors) & (((uint64_t)1 << (width + 1)) - 1));
+		columnTransitions += std::popcount(line ^ previousLine);
+		holes += std::popcount(~line & coveredColumns & fullLineMask);
+
+		uint32_t wellColumns = (uint32_t)(~(uint64_t)line & leftNeighbors & rightNeighbors) & fullLineMask;
+		uint32_t endedWells = previousWells & ~wellColumns;
+
+		while (endedWells != 0)
+		{
+			wellDepths[std::countr_zero(endedWells)] = 0;
+			endedWells &= endedWells - 1;
+		}
+
+		for (uint32_t columns = wellColumns; columns != 0; columns &= columns - 1)
+		{
+			int column = std::countr_zero(columns);
+
+			wellDepths[column]++;
+			wells += wellDepths[column];
+		}
+
+		previousWells = wellColumns;
+		previousLine = line;
+		coveredColumns |= line;
+	}
+
+	//the floor is all blocks
+	columnTransitions += std::popcount(~previousLine & fullLineMask);
+
+	return (float)rowTransitions * BOT_ROW_TRANSITIONS_WEIGHT + (float)columnTransitions * BOT_COLUMN_TRANSITIONS_WEIGHT
+		+ (float)holes * BOT_HOLES_WEIGHT + (float)wells * BOT_WELLS_WEIGHT;
+}
+
+uint64_t Bot::GetLineKey(int y, uint32_t line)
+{
+	//empty lines don't count, like in board hashes
+	return (line != 0) ? GetZobristKey(ZOBRIST_LINE, ((uint64_t)y << 32) | line) : 0;
+}
+
+uint64_t Bot::HashLines(const uint32_t* lines, int stackTop) const
+{
+	uint64_t hash = 0;
+
+	for (int y = stackTop; y < rules.GridSize.y; y++)
+		hash ^= GetLineKey(y, lines[y - stackTop]);
+
+	return hash;
+}
+
+uint64_t Bot::HashNode(const BotNode& node) const
+{
+	uint64_t hash = node.linesHash;
+
+	hash ^= GetZobristKey(ZOBRIST_CURRENT_PIECE, (uint32_t)node.currentType);
+	hash ^= GetZobristKey(ZOBRIST_HOLDING_PIECE, ((uint64_t)(uint32_t)node.holdingType << 32) | (uint32_t)node.holdingRotation);
+
+	//the pieces still to come rather than how far into the queue the node is, so positions are keyed the same by every search
+	for (int i = node.nextPieceIndex; i < (int)upAndComingPieceTypes.size(); i++)
+		hash ^= GetZobristKey(ZOBRIST_UP_AND_COMING_PIECE, ((uint64_t)(i - node.nextPieceIndex) << 32) | (uint32_t)upAndComingPieceTypes[i]);
+
+	return hash;
+}
+
+void Bot::SelectBeam()
+{
+	candidates.clear();
+
+	for (int nodeIndex = 0; nodeIndex < (int)children.size(); nodeIndex++)
+	{
+		for (int childIndex = 0; childIndex < (int)children[nodeIndex].size(); childIndex++)
+			candidates.push_back(std::pair<int, int>(nodeIndex, childIndex));
+	}
+
+	lastNumNodes += (int64_t)candidates.size();
+
+	//stable, so equal scores keep the order of their nodes whichever thread expanded them
+	std::stable_sort(candidates.begin(), candidates.end(), [&](const std::pair<int, int>& a, const std::pair<int, int>& b)
+	{
+		return children[a.first][a.second].score > children[b.first][b.second].score;
+	});
+
+	nextBeam.clear();
+	nextBeamLines.clear();
+
+	for (const std::pair<int, int>& candidate : candidates)
+	{
+		if ((int)nextBeam.size() >= beamWidth)
+			break;
+
+		const BotNode& child = children[candidate.first][candidate.second];
+
+		//the same board and pieces reached through another order of placements
+		bool isKept = false;
+
+		for (const BotNode& keptNode : nextBeam)
+		{
+			if (keptNode.hash == child.hash)
+			{
+				isKept = true;
+				break;
+			}
+		}
+
+		if (isKept)
+			continue;
+
+		//the lines of the kept children are built again from their parents
+		const BotNode& parent = beam[child.parentIndex];
+		const uint32_t* lines = beamLines.data() + parent.linesStart;
+		int numLines = rules.GridSize.y - parent.stackTop;
+
+		if (child.placedType >= 0)
+		{
+			int stackTop = 0;
+			PlaceLines(parent, child.placedType, child.placement, placedLines, stackTop);
+
+			lines = placedLines.data();
+			numLines = (int)placedLines.size();
+		}
+
+		nextBeam.push_back(child);
+		nextBeam.back().linesStart = nextBeamLines.size();
+		nextBeamLines.insert(nextBeamLines.end(), lines, lines + numLines);
+	}
+
+	std::swap(beam, nextBeam);
+	std::swap(beamLines, nextBeamLines);
+}
+
+bool Bot::Think(const Simulation& simulation, BotDecision& decision)
+{
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	lastSearchDepth = 0;
+	lastNumNodes = 0;
+	lastSearchSeconds = 0.0f;
+
+	const Piece& currentPiece = simulation.GetCurrentPiece();
+
+	if (simulation.IsGameOver() || simulation.IsClearingLines() || currentPiece.type < 0)
+		return false;
+
+	rules = simulation.GetRules();
+	isGravityInstant = simulation.IsGravityInstant();
+
+	upAndComingPieceTypes.clear();
+
+	for (int i = 0; i < rules.NumUpAndComingPieces; i++)
+		upAndComingPieceTypes.push_back(simulation.GetUpAndComingPieceType(i));
+
+	for (std::unique_ptr<BotWorker>& worker : workers)
+	{
+		if (worker->board.GetSize().x != rules.GridSize.x || worker->board.GetSize().y != rules.GridSize.y)
+			worker->board.SetSize(rules.GridSize);
+	}
+
+	//the game as it is
+	const Board& board = simulation.GetBoard();
+	const Piece& holdingPiece = simulation.GetHoldingPiece();
+
+	BotNode root = BotNode();
+	root.currentType = currentPiece.type;
+	root.currentRotation = currentPiece.rotation;
+	root.currentPosition = simulation.GetCurrentPiecePosition();
+	root.holdingType = (holdingPiece.numBlocks > 0) ? holdingPiece.type : -1;
+	root.holdingRotation = holdingPiece.rotation;
+	root.canHold = !simulation.HasSwitchedPiece();
+	root.stackTop = board.GetStackTop();
+
+	beam.clear();
+	beamLines.clear();
+	firstChoices.clear();
+
+	if (transpositionTable != nullptr)
+		transpositionTable->StartSearch();
+
+	for (int y = root.stackTop; y < rules.GridSize.y; y++)
+		beamLines.push_back(board.GetRowMask(y));
+
+	root.linesHash = HashLines(beamLines.data(), root.stackTop);
+	root.hash = HashNode(root);
+	beam.push_back(root);
+
+	deadline = startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(timeBudgetSeconds));
+
+	bool hasFoundDecision = false;
+
+	for (int depth = 1; ; depth++)
+	{
+		bool canExpand = false;
+
+		for (const BotNode& node : beam)
+			canExpand |= node.currentType >= 0 && !node.isGameOver;
+
+		if (!canExpand)
+			break;
+
+		//the current piece is always searched whole, deeper searches stop once time is up and the depth before them is used
+		isExpandingRoot = depth == 1;
+		expandingDepth = depth;
+		ExpandBeam(depth > 1);
+		isExpandingRoot = false;
+
+		if (isOutOfTime)
+			break;
+
+		SelectBeam();
+
+		if (beam.empty())
+			break;
+
+		decision = firstChoices[beam[0].firstChoice];
+		decision.score = beam[0].score;
+		decision.depth = depth;
+		hasFoundDecision = true;
+
+		lastSearchDepth = depth;
+	}
+
+	lastSearchSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+
+	return hasFoundDecision;
+}
+
+#pragma endregion
+
+#pragma region Playing
+
+uint64_t Bot::GetDecisionKey(const Simulation& simulation)
+{
+	//a new piece comes up with every placement and hold, which changes the board or the holding piece
+	const Piece& holdingPiece = simulation.GetHoldingPiece();
+
+	uint64_t key = simulation.GetBoard().GetHash();
+	key ^= GetZobristKey(ZOBRIST_CURRENT_PIECE, (uint32_t)simulation.GetCurrentPiece().type);
+	key ^= GetZobristKey(ZOBRIST_HOLDING_PIECE, ((uint64_t)(uint32_t)holdingPiece.type << 1) | (simulation.HasSwitchedPiece() ? 1 : 0));
+
+	for (int i = 0; i < simulation.GetRules().NumUpAndComingPieces; i++)
+		key ^= GetZobristKey(ZOBRIST_UP_AND_COMING_PIECE, ((uint64_t)i << 32) | (uint32_t)simulation.GetUpAndComingPieceType(i));
+
+	return key;
+}
+
+SimulationInput Bot::GetInput(const Simulation& simulation)
+{
+	plannedInputs.clear();
+
+	if (simulation.IsGameOver() || simulation.IsClearingLines())
+		return SimulationInput();
+
+	uint64_t key = GetDecisionKey(simulation);
+
+	//the second try thinks again from where the piece is, if it can't get to the chosen placement anymore
+	for (int attempt = 0; attempt < 2 && plannedInputs.empty(); attempt++)
+	{
+		if (!hasPlannedDecision || plannedDecisionKey != key || attempt > 0)
+		{
+			hasPlannedDecision = Think(simulation, plannedDecision);
+			plannedDecisionKey = key;
+
+			if (!hasPlannedDecision)
+				break;
+		}
+
+		if (plannedDecision.isHolding)
+		{
+			plannedInputs.push_back(SimulationInput(INPUT_HOLD, INPUT_HOLD));
+			break;
+		}
+
+		pathGenerator.Generate(simulation);
+		int placementIndex = pathGenerator.FindPlacement(plannedDecision.placement);
+
+		if (placementIndex >= 0 && pathGenerator.GetPath(placementIndex, path))
+			MoveGenerator::GetPathInputs(path, plannedInputs);
+	}
+
+	//nowhere to go, the piece might as well land where it is
+	if (plannedInputs.empty())
+		plannedInputs.push_back(SimulationInput(INPUT_HARD_DROP, INPUT_HARD_DROP));
+
+	return plannedInputs[0];
+}
+
+const std::vector<SimulationInput>& Bot::GetPlannedInputs() const
+{
+	return plannedInputs;
+}
+
+void Bot::Reset()
+{
+	hasPlannedDecision = false;
+	plannedInputs.clear();
+}
+
+#pragma endregion
+
+#pragma region Accessors
+
+int Bot::GetNumThreads() const
+{
+	return (int)workers.size();
+}
+
+void Bot::SetBeamWidth(int beamWidth)
+{
+	this->beamWidth = std::max(beamWidth, 1);
+}
+
+int Bot::GetBeamWidth() const
+{
+	return beamWidth;
+}
+
+void Bot::SetTimeBudgetSeconds(float seconds)
+{
+	timeBudgetSeconds = std::max(seconds, 0.0f);
+}
+
+float Bot::GetTimeBudgetSeconds() const
+{
+	return timeBudgetSeconds;
+}
+
+void Bot::SetTranspositionTable(std::shared_ptr<TranspositionTable> transpositionTable)
+{
+	this->transpositionTable = transpositionTable;
+}
+
+const std::shared_ptr<TranspositionTable>& Bot::GetTranspositionTable() const
+{
+	return transpositionTable;
+}
+
+int Bot::GetLastSearchDepth() const
+{
+	return lastSearchDepth;
+}
+
+int64_t Bot::GetLastNumNodes() const
+{
+	return lastNumNodes;
+}
+
+float Bot::GetLastSearchSeconds() const
+{
+	return lastSearchSeconds;
+}
+
+#pragma endregion
\ No newline at end of file
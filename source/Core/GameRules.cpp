@@ -0,0 +1,46 @@
+#include "Core/GameRules.h"
+
+//far beyond anything the game offers, but keeps invalid snapshots from allocating huge boards
+const int MAX_GRID_HEIGHT = 1 << 16;
+const int MAX_UP_AND_COMING_PIECES = 1 << 8;
+const int MAX_TICK_RATE = 1 << 16;
+
+bool GameRules::IsSameAs(const GameRules& rules) const
+{
+	return NumUpAndComingPieces == rules.NumUpAndComingPieces && GridSize.x == rules.GridSize.x && GridSize.y == rules.GridSize.y
+		&& Randomizer == rules.Randomizer && TickRate == rules.TickRate && RotationSystem == rules.RotationSystem && Gravity == rules.Gravity
+		&& Pieces->IsSameAs(*rules.Pieces);
+}
+
+void GameRules::WriteSnapshot(SnapshotWriter& writer) const
+{
+	writer.WriteInt(NumUpAndComingPieces);
+	writer.WriteInt(GridSize.x);
+	writer.WriteInt(GridSize.y);
+	writer.WriteInt(Randomizer);
+	writer.WriteInt(TickRate);
+	writer.WriteInt(RotationSystem);
+	writer.WriteInt(Gravity);
+	Pieces->WriteSnapshot(writer);
+}
+
+//Only changes the rules if all of them could be read
+bool GameRules::ReadSnapshot(SnapshotReader& reader)
+{
+	GameRules rules = GameRules();
+	rules.NumUpAndComingPieces = reader.ReadInt(0, MAX_UP_AND_COMING_PIECES);
+	rules.GridSize.x = reader.ReadInt(1, 31);
+	rules.GridSize.y = reader.ReadInt(1, MAX_GRID_HEIGHT);
+	rules.Randomizer = (RandomizerType)reader.ReadInt(0, NUM_RANDOMIZER_TYPES - 1);
+	rules.TickRate = reader.ReadInt(1, MAX_TICK_RATE);
+	rules.RotationSystem = (RotationSystemType)reader.ReadInt(0, NUM_ROTATION_SYSTEM_TYPES - 1);
+	rules.Gravity = (GravityType)reader.ReadInt(0, NUM_GRAVITY_TYPES - 1);
+	rules.Pieces = PieceSet::ReadSnapshot(reader);
+
+	if (!reader.IsValid())
+		return false;
+
+	*this = rules;
+
+	return true;
+}
\ No newline at end of file
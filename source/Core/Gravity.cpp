@@ -0,0 +1,35 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Core/Gravity.h"
+
+const char* GetGravityTypeName(GravityType type)
+{
+	switch (type)
+	{
+		case GRAVITY_CLASSIC:
+			return "CLASSIC";
+		case GRAVITY_TO_20G:
+			return "TO 20G";
+		case GRAVITY_20G:
+			return "20G";
+		default:
+			return "UNKNOWN";
+	}
+}
+
+//Seconds per cell are (0.8 - (level - 1) * 0.007) ^ (level - 1), which passes 20G at level 19
+double GetGravityCellsPerSecond(GravityType type, int level)
+{
+	if (type == GRAVITY_20G)
+		return MAX_GRAVITY_CELLS_PER_SECOND;
+
+	int gravityLevel = level - 1;
+
+	if (type == GRAVITY_CLASSIC)
+		gravityLevel = std::min(gravityLevel, 14);
+
+	double secondsPerCell = std::pow(0.8f - ((float)gravityLevel * 0.007f), (float)gravityLevel);
+
+	return std::min(1.0 / secondsPerCell, MAX_GRAVITY_CELLS_PER_SECOND);
+}
\ No newline at end of file
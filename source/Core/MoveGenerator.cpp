@@ -0,0 +1,604 @@
+#include <bit>
+#include <algorithm>
+
+#include "Core/MoveGenerator.h"
+
+//Pieces kick at most this many lines up at once, the search area has room for a few kicks above where the piece starts
+const int MOVE_AREA_KICK_LINES = 2 * MAX_PIECE_BLOCKS;
+
+//Rotation each rotation move turns the piece by, in clockwise quarter turns
+const int MOVE_QUARTER_TURNS[NUM_PIECE_MOVES] = { 0, 0, 1, 3, 2, 0, 0 };
+
+//Input action of each move
+const SimulationInputAction MOVE_INPUT_ACTIONS[NUM_PIECE_MOVES] =
+{
+	INPUT_MOVE_LEFT,
+	INPUT_MOVE_RIGHT,
+	INPUT_ROTATE_CLOCKWISE,
+	INPUT_ROTATE_COUNTER_CLOCKWISE,
+	INPUT_ROTATE_HALF_CIRCLE,
+	INPUT_SOFT_DROP,
+	INPUT_HARD_DROP
+};
+
+//Part of a tick each move is applied in: rotation, then sideways movement, then dropping
+const int MOVE_TICK_STAGES[NUM_PIECE_MOVES] = { 1, 1, 0, 0, 0, 2, 2 };
+
+static bool IsSameMask(const PieceMask& a, const PieceMask& b)
+{
+	if (a.width != b.width || a.height != b.height)
+		return false;
+
+	for (int row = 0; row < a.height; row++)
+	{
+		if (a.rows[row] != b.rows[row])
+			return false;
+	}
+
+	return true;
+}
+
+#pragma region Search
+
+uint64_t MoveGenerator::GetFitMask(int rotation, int line)
+{
+	int index = rotation * areaHeight + line;
+
+	if (lines[index].hasFitColumns)
+		return lines[index].fitColumns;
+
+	//a padded row mask has the grid's column 0 at bit BOARD_KICK_PADDING, shifting it right by the column of a block relative to areaLeft
+	//lines the bit of every origin column up with the cell that block would cover
+	const PieceMask& mask = masks[rotation];
+	int y = areaTop + line + mask.top;
+
+	bool isAboveStack = y + mask.height <= stackTop;
+
+	if (isAboveStack && hasOpenFitMask[rotation])
+	{
+		lines[index].fitColumns = openFitMasks[rotation];
+		lines[index].hasFitColumns = true;
+
+		return lines[index].fitColumns;
+	}
+
+	uint64_t blockedColumns = 0;
+
+	for (int row = 0; row < mask.height; row++)
+	{
+		uint64_t rowMask = board->GetPaddedRowMask(y + row);
+		uint32_t pieceRow = mask.rows[row];
+
+		while (pieceRow != 0)
+		{
+			int column = std::countr_zero(pieceRow);
+			pieceRow &= pieceRow - 1;
+
+			blockedColumns |= rowMask >> (BOARD_KICK_PADDING + areaLeft + mask.left + column);
+		}
+	}
+
+	lines[index].fitColumns = ~blockedColumns & areaColumnsMask;
+	lines[index].hasFitColumns = true;
+
+	if (isAboveStack)
+	{
+		openFitMasks[rotation] = lines[index].fitColumns;
+		hasOpenFitMask[rotation] = true;
+	}
+
+	return lines[index].fitColumns;
+}
+
+void MoveGenerator::AddReached(int rotation, int line, uint64_t columns)
+{
+	int index = rotation * areaHeight + line;
+	columns &= ~lines[index].reachedColumns;
+
+	if (columns == 0)
+		return;
+
+	lines[index].reachedColumns |= columns;
+
+	if (!lines[index].isPending)
+	{
+		lines[index].isPending = true;
+		pendingLines.push_back(index);
+	}
+}
+
+void MoveGenerator::ExpandLine(int index)
+{
+	lines[index].isPending = false;
+
+	int rotation = index / areaHeight;
+	int line = index % areaHeight;
+
+	//moving sideways reaches every column the piece fits at next to a reached one
+	uint64_t fitMask = GetFitMask(rotation, line);
+	uint64_t columns = lines[index].reachedColumns;
+
+	while (true)
+	{
+		uint64_t movedColumns = columns | (((columns << 1) | (columns >> 1)) & fitMask);
+
+		if (movedColumns == columns)
+			break;
+
+		columns = movedColumns;
+	}
+
+	lines[index].reachedColumns = columns;
+
+	//every other move is only made from columns that haven't been moved from yet
+	uint64_t newColumns = columns & ~lines[index].expandedColumns;
+	lines[index].expandedColumns = columns;
+
+	if (newColumns == 0)
+		return;
+
+	//soft drop
+	if (line + 1 < areaHeight)
+		AddReached(rotation, line + 1, newColumns & GetFitMask(rotation, line + 1));
+
+	if (!canRotate)
+		return;
+
+	for (int move = MOVE_ROTATE_CLOCKWISE; move <= MOVE_ROTATE_HALF_CIRCLE; move++)
+	{
+		int toRotation = (rotation + MOVE_QUARTER_TURNS[move]) % NUM_PIECE_ROTATIONS;
+		const RotationKicks& kicks = GetRotationKicks(rotationSystem, *pieceSet, pieceType, rotation, toRotation);
+
+		uint64_t kickedColumns = newColumns;
+
+		//kicks that are tested in place first rotate every column the rotated piece fits at in place, the other columns are kicked one by one
+		if (kicks.isScaledByBlockedWidth || (kicks.numOffsets > 0 && kicks.offsets[0].x == 0 && kicks.offsets[0].y == 0))
+		{
+			uint64_t toFitMask = GetFitMask(toRotation, line);
+
+			AddReached(toRotation, line, newColumns & toFitMask);
+			kickedColumns &= ~toFitMask;
+		}
+
+		while (kickedColumns != 0)
+		{
+			int column = std::countr_zero(kickedColumns);
+			kickedColumns &= kickedColumns - 1;
+
+			int movedRotation = rotation;
+			Vector2Int position = Vector2Int{ areaLeft + column, areaTop + line };
+
+			if (ApplyMove((PieceMove)move, movedRotation, position))
+				AddReached(movedRotation, position.y - areaTop, (uint64_t)1 << (position.x - areaLeft));
+		}
+	}
+}
+
+bool MoveGenerator::ApplyMove(PieceMove move, int& rotation, Vector2Int& position)
+{
+	int column = position.x - areaLeft;
+	int line = position.y - areaTop;
+
+	switch (move)
+	{
+		case MOVE_LEFT:
+			if (column <= 0 || (GetFitMask(rotation, line) & ((uint64_t)1 << (column - 1))) == 0)
+				return false;
+
+			position.x--;
+			return true;
+		case MOVE_RIGHT:
+			if (column + 1 >= areaWidth || (GetFitMask(rotation, line) & ((uint64_t)1 << (column + 1))) == 0)
+				return false;
+
+			position.x++;
+			return true;
+		case MOVE_SOFT_DROP:
+			if (line + 1 >= areaHeight || (GetFitMask(rotation, line + 1) & ((uint64_t)1 << column)) == 0)
+				return false;
+
+			position.y++;
+			return true;
+		case MOVE_ROTATE_CLOCKWISE:
+		case MOVE_ROTATE_COUNTER_CLOCKWISE:
+		case MOVE_ROTATE_HALF_CIRCLE:
+		{
+			if (!canRotate)
+				return false;
+
+			int toRotation = (rotation + MOVE_QUARTER_TURNS[move]) % NUM_PIECE_ROTATIONS;
+			const RotationKicks& kicks = GetRotationKicks(rotationSystem, *pieceSet, pieceType, rotation, toRotation);
+
+			const Vector2Int* offsets = kicks.offsets;
+			Vector2Int scaledOffsets[MAX_ROTATION_KICKS];
+
+			//the same classic kicks as KickPieceRotation, scaled by the blocked width of the piece rotated in place
+			if (kicks.isScaledByBlockedWidth)
+			{
+				uint32_t blockedColumns = board->GetBlockedColumns(masks[toRotation], position);
+				int blockedWidth = (blockedColumns != 0) ? 32 - std::countl_zero(blockedColumns) - std::countr_zero(blockedColumns) : 0;
+
+				for (int i = 0; i < kicks.numOffsets; i++)
+					scaledOffsets[i] = Vector2Int{ kicks.offsets[i].x * blockedWidth, kicks.offsets[i].y };
+
+				offsets = scaledOffsets;
+			}
+
+			//each kick is a fit mask test, the first offset the rotated piece fits at is taken.
+			//Pieces never fit outside of the area's columns or below it, kicks above it are left to the board.
+			int kickIndex = 0;
+
+			for (; kickIndex < kicks.numOffsets; kickIndex++)
+			{
+				int kickedColumn = column + offsets[kickIndex].x;
+				int kickedLine = line + offsets[kickIndex].y;
+
+				if (kickedLine < 0)
+					break;
+
+				if (kickedColumn < 0 || kickedColumn >= areaWidth || kickedLine >= areaHeight)
+					continue;
+
+				if ((GetFitMask(toRotation, kickedLine) & ((uint64_t)1 << kickedColumn)) != 0)
+				{
+					rotation = toRotation;
+					position = Vector2Int{ position.x + offsets[kickIndex].x, position.y + offsets[kickIndex].y };
+					return true;
+				}
+			}
+
+			if (kickIndex == kicks.numOffsets)
+				return false;
+
+			Vector2Int kickedPosition = position;
+
+			if (!KickPieceRotation(*board, rotationSystem, *pieceSet, pieceType, rotation, toRotation, kickedPosition))
+				return false;
+
+			//kicked out of the search area, which only pieces climbing walls further than any kick table does get to
+			if (kickedPosition.x < areaLeft || kickedPosition.x >= areaLeft + areaWidth || kickedPosition.y < areaTop || kickedPosition.y >= areaTop + areaHeight)
+				return false;
+
+			rotation = toRotation;
+			position = kickedPosition;
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+void MoveGenerator::AddPlacement(int rotation, Vector2Int position)
+{
+	//placements are compared in the position of their rotation class, so rotations covering the same cells count as one
+	int rotationClass = rotationClasses[rotation];
+	int column = position.x + masks[rotation].left - masks[rotationClass].left - areaLeft;
+	int line = position.y + masks[rotation].top - masks[rotationClass].top - areaTop;
+
+	if (column >= 0 && column < areaWidth && line >= 0 && line < areaHeight)
+	{
+		uint64_t& placedMask = lines[rotationClass * areaHeight + line].placedColumns;
+		uint64_t columnBit = (uint64_t)1 << column;
+
+		if ((placedMask & columnBit) != 0)
+			return;
+
+		placedMask |= columnBit;
+	}
+
+	placements.push_back(MovePlacement{ rotation, position });
+}
+
+void MoveGenerator::GenerateInstant()
+{
+	//a rotation, then a move sideways, after which the piece lands right away
+	const PieceMove rotationMoves[] = { NUM_PIECE_MOVES, MOVE_ROTATE_CLOCKWISE, MOVE_ROTATE_COUNTER_CLOCKWISE, MOVE_ROTATE_HALF_CIRCLE };
+	const PieceMove sidewaysMoves[] = { NUM_PIECE_MOVES, MOVE_LEFT, MOVE_RIGHT };
+
+	for (PieceMove rotationMove : rotationMoves)
+	{
+		int rotation = start.rotation;
+		Vector2Int position = start.position;
+
+		if (rotationMove != NUM_PIECE_MOVES && !ApplyMove(rotationMove, rotation, position))
+			continue;
+
+		for (PieceMove sidewaysMove : sidewaysMoves)
+		{
+			int movedRotation = rotation;
+			Vector2Int movedPosition = position;
+
+			if (sidewaysMove != NUM_PIECE_MOVES && !ApplyMove(sidewaysMove, movedRotation, movedPosition))
+				continue;
+
+			movedPosition.y += board->GetDropDistance(masks[movedRotation], movedPosition);
+
+			AddPlacement(movedRotation, movedPosition);
+		}
+	}
+}
+
+void MoveGenerator::Generate(const Board& board, RotationSystemType rotationSystem, const PieceSet& pieceSet, const Piece& piece, Vector2Int position, bool isGravityInstant)
+{
+	this->board = &board;
+	this->pieceSet = &pieceSet;
+	this->rotationSystem = rotationSystem;
+	this->isGravityInstant = isGravityInstant;
+
+	pieceType = piece.type;
+	canRotate = piece.type >= 0;
+	start = MovePlacement{ piece.rotation % NUM_PIECE_ROTATIONS, position };
+
+	placements.clear();
+
+	for (int rotation = 0; rotation < NUM_PIECE_ROTATIONS; rotation++)
+	{
+		if (canRotate)
+			masks[rotation] = pieceSet.GetShape(piece.type, rotation).mask;
+		else
+			masks[rotation] = PieceMask::FromPiece(piece);
+
+		rotationClasses[rotation] = rotation;
+		hasOpenFitMask[rotation] = false;
+
+		for (int classRotation = 0; classRotation < rotation; classRotation++)
+		{
+			if (IsSameMask(masks[classRotation], masks[rotation]))
+			{
+				rotationClasses[rotation] = classRotation;
+				break;
+			}
+		}
+	}
+
+	//pieces without blocks (after a game over) don't land anywhere, nor do pieces too far from their origin for the column masks
+	const PieceMask& startMask = masks[start.rotation];
+
+	if (startMask.height == 0 || startMask.left < -MAX_PIECE_BLOCKS || startMask.left + startMask.width > MAX_PIECE_BLOCKS + 1)
+		return;
+
+	//every origin a block of the piece can be in the grid from, plus room above the start for kicks
+	Vector2Int gridSize = board.GetSize();
+
+	areaLeft = -MAX_PIECE_BLOCKS;
+	areaTop = std::min(position.y, 0) - MOVE_AREA_KICK_LINES;
+	areaWidth = gridSize.x + 2 * MAX_PIECE_BLOCKS;
+	areaHeight = gridSize.y + MAX_PIECE_BLOCKS - areaTop;
+	areaColumnsMask = ((uint64_t)1 << areaWidth) - 1;
+
+	stackTop = board.GetStackTop();
+
+	int numLines = NUM_PIECE_ROTATIONS * areaHeight;
+
+	lines.assign(numLines, MoveLine());
+	pendingLines.clear();
+
+	int startColumn = position.x - areaLeft;
+	int startLine = position.y - areaTop;
+
+	if (startColumn < 0 || startColumn >= areaWidth || startLine >= areaHeight || (GetFitMask(start.rotation, startLine) & ((uint64_t)1 << startColumn)) == 0)
+		return;
+
+	if (isGravityInstant)
+	{
+		GenerateInstant();
+		return;
+	}
+
+	AddReached(start.rotation, startLine, (uint64_t)1 << startColumn);
+
+	while (!pendingLines.empty())
+	{
+		int index = pendingLines.back();
+		pendingLines.pop_back();
+
+		ExpandLine(index);
+	}
+
+	//the piece comes to rest wherever it was reached and can't move down from
+	for (int rotation = 0; rotation < NUM_PIECE_ROTATIONS; rotation++)
+	{
+		for (int line = 0; line < areaHeight; line++)
+		{
+			uint64_t columns = lines[rotation * areaHeight + line].reachedColumns;
+
+			if (columns == 0)
+				continue;
+
+			if (line + 1 < areaHeight)
+				columns &= ~GetFitMask(rotation, line + 1);
+
+			while (columns != 0)
+			{
+				int column = std::countr_zero(columns);
+				columns &= columns - 1;
+
+				AddPlacement(rotation, Vector2Int{ areaLeft + column, areaTop + line });
+			}
+		}
+	}
+}
+
+void MoveGenerator::Generate(const Simulation& simulation)
+{
+	const GameRules& rules = simulation.GetRules();
+
+	Generate(simulation.GetBoard(), rules.RotationSystem, *rules.Pieces, simulation.GetCurrentPiece(), simulation.GetCurrentPiecePosition(), simulation.IsGravityInstant());
+}
+
+#pragma endregion
+
+#pragma region Placements
+
+int MoveGenerator::GetNumPlacements() const
+{
+	return (int)placements.size();
+}
+
+const MovePlacement& MoveGenerator::GetPlacement(int index) const
+{
+	return placements[index];
+}
+
+int MoveGenerator::FindPlacement(const MovePlacement& placement) const
+{
+	//compared in the position of their rotation class, like when they were found
+	int rotationClass = rotationClasses[placement.rotation];
+	int classX = placement.position.x + masks[placement.rotation].left - masks[rotationClass].left;
+	int classY = placement.position.y + masks[placement.rotation].top - masks[rotationClass].top;
+
+	for (int i = 0; i < (int)placements.size(); i++)
+	{
+		const MovePlacement& other = placements[i];
+
+		if (rotationClasses[other.rotation] != rotationClass)
+			continue;
+
+		if (other.position.x + masks[other.rotation].left - masks[rotationClass].left == classX && other.position.y + masks[other.rotation].top - masks[rotationClass].top == classY)
+			return i;
+	}
+
+	return -1;
+}
+
+bool MoveGenerator::GetInstantPath(const MovePlacement& placement, std::vector<PieceMove>& path)
+{
+	const PieceMove rotationMoves[] = { NUM_PIECE_MOVES, MOVE_ROTATE_CLOCKWISE, MOVE_ROTATE_COUNTER_CLOCKWISE, MOVE_ROTATE_HALF_CIRCLE };
+	const PieceMove sidewaysMoves[] = { NUM_PIECE_MOVES, MOVE_LEFT, MOVE_RIGHT };
+
+	for (PieceMove rotationMove : rotationMoves)
+	{
+		int rotation = start.rotation;
+		Vector2Int position = start.position;
+
+		if (rotationMove != NUM_PIECE_MOVES && !ApplyMove(rotationMove, rotation, position))
+			continue;
+
+		for (PieceMove sidewaysMove : sidewaysMoves)
+		{
+			int movedRotation = rotation;
+			Vector2Int movedPosition = position;
+
+			if (sidewaysMove != NUM_PIECE_MOVES && !ApplyMove(sidewaysMove, movedRotation, movedPosition))
+				continue;
+
+			movedPosition.y += board->GetDropDistance(masks[movedRotation], movedPosition);
+
+			if (movedRotation != placement.rotation || movedPosition.x != placement.position.x || movedPosition.y != placement.position.y)
+				continue;
+
+			if (rotationMove != NUM_PIECE_MOVES)
+				path.push_back(rotationMove);
+
+			if (sidewaysMove != NUM_PIECE_MOVES)
+				path.push_back(sidewaysMove);
+
+			path.push_back(MOVE_HARD_DROP);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool MoveGenerator::GetPath(int index, std::vector<PieceMove>& path)
+{
+	path.clear();
+
+	if (index < 0 || index >= (int)placements.size())
+		return false;
+
+	const MovePlacement& placement = placements[index];
+
+	if (isGravityInstant)
+		return GetInstantPath(placement, path);
+
+	//breadth first over single moves, so the first state that hard drops onto the placement is reached by one of the fewest moves
+	int numStates = NUM_PIECE_ROTATIONS * areaHeight * areaWidth;
+	pathParents.assign(numStates, -1);
+	pathMoves.resize(numStates);
+	pathQueue.clear();
+
+	int targetColumn = placement.position.x - areaLeft;
+	int targetLine = placement.position.y - areaTop;
+
+	int startState = (start.rotation * areaHeight + (start.position.y - areaTop)) * areaWidth + (start.position.x - areaLeft);
+	pathParents[startState] = startState;
+	pathQueue.push_back(startState);
+
+	for (size_t queueIndex = 0; queueIndex < pathQueue.size(); queueIndex++)
+	{
+		int state = pathQueue[queueIndex];
+		int rotation = state / (areaHeight * areaWidth);
+		int line = (state / areaWidth) % areaHeight;
+		int column = state % areaWidth;
+
+		//in the placement's column above it, does it drop all the way down onto it?
+		if (rotation == placement.rotation && column == targetColumn && line <= targetLine)
+		{
+			int dropLine = line;
+
+			while (dropLine < targetLine && (GetFitMask(rotation, dropLine + 1) & ((uint64_t)1 << column)) != 0)
+				dropLine++;
+
+			if (dropLine == targetLine && (dropLine + 1 >= areaHeight || (GetFitMask(rotation, dropLine + 1) & ((uint64_t)1 << column)) == 0))
+			{
+				path.push_back(MOVE_HARD_DROP);
+
+				while (pathParents[state] != state)
+				{
+					path.push_back((PieceMove)pathMoves[state]);
+					state = pathParents[state];
+				}
+
+				std::reverse(path.begin(), path.end());
+				return true;
+			}
+		}
+
+		for (int move = 0; move < MOVE_HARD_DROP; move++)
+		{
+			int movedRotation = rotation;
+			Vector2Int position = Vector2Int{ areaLeft + column, areaTop + line };
+
+			if (!ApplyMove((PieceMove)move, movedRotation, position))
+				continue;
+
+			int movedState = (movedRotation * areaHeight + (position.y - areaTop)) * areaWidth + (position.x - areaLeft);
+
+			if (pathParents[movedState] >= 0)
+				continue;
+
+			pathParents[movedState] = state;
+			pathMoves[movedState] = (uint8_t)move;
+			pathQueue.push_back(movedState);
+		}
+	}
+
+	return false;
+}
+
+void MoveGenerator::GetPathInputs(const std::vector<PieceMove>& path, std::vector<SimulationInput>& inputs)
+{
+	unsigned int actions = INPUT_NONE;
+	int tickStage = -1;
+
+	for (PieceMove move : path)
+	{
+		//a tick can't go back to an earlier stage or do a stage twice, the move has to wait for the next tick
+		if (MOVE_TICK_STAGES[move] <= tickStage)
+		{
+			inputs.push_back(SimulationInput(actions, actions));
+
+			actions = INPUT_NONE;
+		}
+
+		actions |= MOVE_INPUT_ACTIONS[move];
+		tickStage = MOVE_TICK_STAGES[move];
+	}
+
+	if (actions != INPUT_NONE)
+		inputs.push_back(SimulationInput(actions, actions));
+}
+
+#pragma endregion
\ No newline at end of file
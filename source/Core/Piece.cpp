@@ -0,0 +1,125 @@
+#include <cstdint>
+
+#include "Core/Piece.h"
+#include "Core/PieceTables.h"
+
+Piece Piece::GetClockwiseRotation() const
+{
+	Piece rotatedPiece = Piece(numBlocks);
+	rotatedPiece.pivotOffset = pivotOffset;
+	rotatedPiece.colorIndex = colorIndex;
+	rotatedPiece.type = type;
+	rotatedPiece.rotation = (rotation + 1) % NUM_PIECE_ROTATIONS;
+
+	//rotating around pivot
+	//90 degrees clockwise rotation
+	for (int i = 0; i < numBlocks; i++)
+	{
+		rotatedPiece.blockOffsets[i].x = (int)(-blockOffsets[i].y + pivotOffset.y + pivotOffset.x);
+		rotatedPiece.blockOffsets[i].y = (int)(blockOffsets[i].x - pivotOffset.x + pivotOffset.y);
+	}
+
+	return rotatedPiece;
+}
+
+Piece Piece::GetCounterClockwiseRotation() const
+{
+	Piece rotatedPiece = Piece(numBlocks);
+	rotatedPiece.pivotOffset = pivotOffset;
+	rotatedPiece.colorIndex = colorIndex;
+	rotatedPiece.type = type;
+	rotatedPiece.rotation = (rotation + 3) % NUM_PIECE_ROTATIONS;
+
+	//rotating around pivot
+	//90 degrees counter-clockwise rotation
+	for (int i = 0; i < numBlocks; i++)
+	{
+		rotatedPiece.blockOffsets[i].x = (int)(blockOffsets[i].y - pivotOffset.y + pivotOffset.x);
+		rotatedPiece.blockOffsets[i].y = (int)(-blockOffsets[i].x + pivotOffset.x + pivotOffset.y);
+	}
+
+	return rotatedPiece;
+}
+
+Piece Piece::GetHalfCircleRotation() const
+{
+	Piece rotatedPiece = Piece(numBlocks);
+	rotatedPiece.pivotOffset = pivotOffset;
+	rotatedPiece.colorIndex = colorIndex;
+	rotatedPiece.type = type;
+	rotatedPiece.rotation = (rotation + 2) % NUM_PIECE_ROTATIONS;
+
+	//180 degrees rotation, doesn't matter if it's clockwise or counter-clockwise
+	//newX - pivotX = -(oldX - pivotX)
+	for (int i = 0; i < numBlocks; i++)
+	{
+		rotatedPiece.blockOffsets[i].x = -blockOffsets[i].x + (int)(2 * pivotOffset.x);
+		rotatedPiece.blockOffsets[i].y = -blockOffsets[i].y + (int)(2 * pivotOffset.y);
+	}
+
+	return rotatedPiece;
+}
+
+Vector2Int Piece::Measure() const
+{
+	int left = INT32_MAX;
+	int right = INT32_MIN;
+
+	int top = INT32_MAX;
+	int bottom = INT32_MIN;
+
+	for (int i = 0; i < numBlocks; i++)
+	{
+		if (blockOffsets[i].x < left)
+			left = blockOffsets[i].x;
+		else if (blockOffsets[i].x > right)
+			right = blockOffsets[i].x;
+
+		if (blockOffsets[i].y < top)
+			top = blockOffsets[i].y;
+		else if (blockOffsets[i].y > bottom)
+			bottom = blockOffsets[i].y;
+	}
+
+	return { right - left, bottom - top };
+}
+
+RectangleInt Piece::GetBounds() const
+{
+	int left = INT32_MAX;
+	int right = INT32_MIN;
+
+	int top = INT32_MAX;
+	int bottom = INT32_MIN;
+
+	for (int i = 0; i < numBlocks; i++)
+	{
+		if (blockOffsets[i].x < left)
+			left = blockOffsets[i].x;
+		else if (blockOffsets[i].x > right)
+			right = blockOffsets[i].x;
+
+		if (blockOffsets[i].y < top)
+			top = blockOffsets[i].y;
+		else if (blockOffsets[i].y > bottom)
+			bottom = blockOffsets[i].y;
+	}
+
+	return { left, top, right - left, bottom - top };
+}
+
+Piece Piece::GetMainPiece(MainPieceType mainPieceType)
+{
+	const MainPieceDefinition& definition = MAIN_PIECE_DEFINITIONS[mainPieceType];
+	const PieceShape& shape = GetMainPieceShape(mainPieceType, 0);
+
+	Piece newPiece = Piece(shape.numBlocks);
+	newPiece.pivotOffset = definition.pivotOffset;
+	newPiece.colorIndex = definition.colorIndex;
+	newPiece.type = mainPieceType;
+
+	for (int i = 0; i < shape.numBlocks; i++)
+		newPiece.blockOffsets[i] = shape.blockOffsets[i];
+
+	return newPiece;
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+#include "Core/PieceMask.h"
+
+PieceMask PieceMask::FromPiece(const Piece& piece)
+{
+	return FromBlocks(piece.blockOffsets, piece.numBlocks);
+}
\ No newline at end of file
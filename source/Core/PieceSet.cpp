@@ -0,0 +1,343 @@
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "Core/PieceSet.h"
+
+//Longest name of a piece set
+const size_t PIECE_SET_MAX_NAME_LENGTH = 64;
+
+struct PaletteColorName
+{
+	const char* name;
+	BlockPaletteIndex colorIndex;
+};
+
+const PaletteColorName PALETTE_COLOR_NAMES[] =
+{
+	{ "YELLOW", PALETTE_YELLOW },
+	{ "SKY_BLUE", PALETTE_SKY_BLUE },
+	{ "RED", PALETTE_RED },
+	{ "GREEN", PALETTE_GREEN },
+	{ "ORANGE", PALETTE_ORANGE },
+	{ "PINK", PALETTE_PINK },
+	{ "PURPLE", PALETTE_PURPLE }
+};
+
+PieceSet::PieceSet(std::string name)
+{
+	this->name = name;
+}
+
+std::shared_ptr<const PieceSet> PieceSet::GetStandard()
+{
+	static const std::shared_ptr<const PieceSet> standardPieceSet = []()
+	{
+		std::shared_ptr<PieceSet> pieceSet = std::make_shared<PieceSet>("STANDARD");
+		pieceSet->isStandard = true;
+
+		//the shapes were already compiled into MAIN_PIECE_SHAPES
+		for (int type = 0; type < NUM_MAIN_PIECES; type++)
+		{
+			PieceDefinition definition = PieceDefinition();
+			definition.pivotOffset = MAIN_PIECE_DEFINITIONS[type].pivotOffset;
+			definition.numBlocks = NUM_MAIN_PIECE_BLOCKS;
+			definition.colorIndex = MAIN_PIECE_DEFINITIONS[type].colorIndex;
+
+			for (int i = 0; i < NUM_MAIN_PIECE_BLOCKS; i++)
+				definition.blockOffsets[i] = MAIN_PIECE_DEFINITIONS[type].blockOffsets[i];
+
+			pieceSet->definitions.push_back(definition);
+
+			for (int rotation = 0; rotation < NUM_PIECE_ROTATIONS; rotation++)
+				pieceSet->shapes.push_back(GetMainPieceShape((MainPieceType)type, rotation));
+		}
+
+		return pieceSet;
+	}();
+
+	return standardPieceSet;
+}
+
+//One piece per line, lines starting with # are comments:
+//	name <name of the set>
+//	piece <color> <pivot x> <pivot y> <block x>,<block y> <block x>,<block y> ...
+//Colors are BLOCK_PALETTE names such as SKY_BLUE, y goes down.
+std::shared_ptr<PieceSet> PieceSet::Load(const std::string& text, std::string& error)
+{
+	std::shared_ptr<PieceSet> pieceSet = std::make_shared<PieceSet>("CUSTOM");
+
+	std::istringstream textStream = std::istringstream(text);
+	std::string line;
+	int lineNumber = 0;
+
+	while (std::getline(textStream, line))
+	{
+		lineNumber++;
+
+		line = line.substr(0, line.find('#'));
+
+		std::istringstream lineStream = std::istringstream(line);
+		std::string keyword;
+
+		if (!(lineStream >> keyword))
+			continue;
+
+		if (keyword == "name")
+		{
+			std::getline(lineStream >> std::ws, pieceSet->name);
+
+			//trailing whitespace, such as the carriage return of windows line endings
+			pieceSet->name.erase(pieceSet->name.find_last_not_of(" \t\r") + 1);
+
+			if (pieceSet->name.empty() || pieceSet->name.size() > PIECE_SET_MAX_NAME_LENGTH)
+			{
+				error = "line " + std::to_string(lineNumber) + ": name must be between 1 and " + std::to_string(PIECE_SET_MAX_NAME_LENGTH) + " characters";
+				return nullptr;
+			}
+		}
+		else if (keyword == "piece")
+		{
+			PieceDefinition definition = PieceDefinition();
+			std::string colorName;
+
+			if (!(lineStream >> colorName >> definition.pivotOffset.x >> definition.pivotOffset.y))
+			{
+				error = "line " + std::to_string(lineNumber) + ": expected a color and a pivot";
+				return nullptr;
+			}
+
+			for (const PaletteColorName& paletteColorName : PALETTE_COLOR_NAMES)
+			{
+				if (colorName == paletteColorName.name)
+					definition.colorIndex = paletteColorName.colorIndex;
+			}
+
+			if (definition.colorIndex == PALETTE_BLANK)
+			{
+				error = "line " + std::to_string(lineNumber) + ": unknown color " + colorName;
+				return nullptr;
+			}
+
+			std::string block;
+
+			while (lineStream >> block)
+			{
+				Vector2Int offset = Vector2Int(0, 0);
+				char separator = 0;
+				std::istringstream blockStream = std::istringstream(block);
+
+				if (definition.numBlocks == MAX_PIECE_BLOCKS || !(blockStream >> offset.x >> separator >> offset.y) || separator != ',' || !blockStream.eof())
+				{
+					error = "line " + std::to_string(lineNumber) + ": invalid block " + block + ", pieces have at most " + std::to_string(MAX_PIECE_BLOCKS) + " blocks written as x,y";
+					return nullptr;
+				}
+
+				definition.blockOffsets[definition.numBlocks++] = offset;
+			}
+
+			if (!pieceSet->AddPiece(definition))
+			{
+				error = "line " + std::to_string(lineNumber) + ": invalid piece, blocks must be unique and stay within " + std::to_string(PIECE_SET_MAX_BLOCK_OFFSET) + " cells of the origin in every rotation";
+				return nullptr;
+			}
+		}
+		else
+		{
+			error = "line " + std::to_string(lineNumber) + ": unknown keyword " + keyword;
+			return nullptr;
+		}
+	}
+
+	if (pieceSet->GetNumPieces() == 0)
+	{
+		error = "piece set has no pieces";
+		return nullptr;
+	}
+
+	return pieceSet;
+}
+
+std::shared_ptr<PieceSet> PieceSet::LoadFromFile(const std::string& path, std::string& error)
+{
+	std::ifstream file = std::ifstream(path);
+
+	if (!file.is_open())
+	{
+		error = "could not open " + path;
+		return nullptr;
+	}
+
+	std::stringstream text;
+	text << file.rdbuf();
+
+	std::shared_ptr<PieceSet> pieceSet = Load(text.str(), error);
+
+	if (pieceSet == nullptr)
+		error = path + ", " + error;
+
+	return pieceSet;
+}
+
+bool PieceSet::AddPiece(const PieceDefinition& definition)
+{
+	if ((int)definitions.size() == PIECE_SET_MAX_PIECES || definition.numBlocks < 1 || definition.numBlocks > MAX_PIECE_BLOCKS)
+		return false;
+
+	if (definition.colorIndex == PALETTE_BLANK || definition.colorIndex >= NUM_PALETTE_COLORS)
+		return false;
+
+	PieceShape shape = PieceShape();
+	shape.numBlocks = definition.numBlocks;
+
+	for (int i = 0; i < definition.numBlocks; i++)
+	{
+		//two blocks in the same cell
+		for (int j = 0; j < i; j++)
+		{
+			if (shape.blockOffsets[j].x == definition.blockOffsets[i].x && shape.blockOffsets[j].y == definition.blockOffsets[i].y)
+				return false;
+		}
+
+		shape.blockOffsets[i] = definition.blockOffsets[i];
+	}
+
+	shape.mask = PieceMask::FromBlocks(shape.blockOffsets, shape.numBlocks);
+
+	PieceShape rotationShapes[NUM_PIECE_ROTATIONS];
+
+	for (int rotation = 0; rotation < NUM_PIECE_ROTATIONS; rotation++)
+	{
+		for (int i = 0; i < shape.numBlocks; i++)
+		{
+			if (std::abs(shape.blockOffsets[i].x) > PIECE_SET_MAX_BLOCK_OFFSET || std::abs(shape.blockOffsets[i].y) > PIECE_SET_MAX_BLOCK_OFFSET)
+				return false;
+		}
+
+		rotationShapes[rotation] = shape;
+		shape = shape.GetClockwiseRotation(definition.pivotOffset);
+	}
+
+	definitions.push_back(definition);
+	shapes.insert(shapes.end(), rotationShapes, rotationShapes + NUM_PIECE_ROTATIONS);
+
+	return true;
+}
+
+const std::string& PieceSet::GetName() const
+{
+	return name;
+}
+
+bool PieceSet::IsStandard() const
+{
+	return isStandard;
+}
+
+int PieceSet::GetNumPieces() const
+{
+	return (int)definitions.size();
+}
+
+const PieceDefinition& PieceSet::GetDefinition(int type) const
+{
+	return definitions[type];
+}
+
+Piece PieceSet::GetPiece(int type) const
+{
+	const PieceDefinition& definition = definitions[type];
+	const PieceShape& shape = GetShape(type, 0);
+
+	Piece piece = Piece(shape.numBlocks);
+	piece.pivotOffset = definition.pivotOffset;
+	piece.colorIndex = definition.colorIndex;
+	piece.type = type;
+
+	for (int i = 0; i < shape.numBlocks; i++)
+		piece.blockOffsets[i] = shape.blockOffsets[i];
+
+	return piece;
+}
+
+bool PieceSet::IsSameAs(const PieceSet& pieceSet) const
+{
+	if (this == &pieceSet)
+		return true;
+
+	if (isStandard != pieceSet.isStandard || name != pieceSet.name || definitions.size() != pieceSet.definitions.size())
+		return false;
+
+	for (size_t type = 0; type < definitions.size(); type++)
+	{
+		const PieceDefinition& definition = definitions[type];
+		const PieceDefinition& otherDefinition = pieceSet.definitions[type];
+
+		if (definition.numBlocks != otherDefinition.numBlocks || definition.colorIndex != otherDefinition.colorIndex
+			|| definition.pivotOffset.x != otherDefinition.pivotOffset.x || definition.pivotOffset.y != otherDefinition.pivotOffset.y)
+			return false;
+
+		for (int i = 0; i < definition.numBlocks; i++)
+		{
+			if (definition.blockOffsets[i].x != otherDefinition.blockOffsets[i].x || definition.blockOffsets[i].y != otherDefinition.blockOffsets[i].y)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+//The standard set is only a flag, other sets are written piece by piece
+void PieceSet::WriteSnapshot(SnapshotWriter& writer) const
+{
+	writer.WriteBool(isStandard);
+
+	if (isStandard)
+		return;
+
+	writer.WriteString(name);
+	writer.WriteInt((int)definitions.size());
+
+	for (const PieceDefinition& definition : definitions)
+	{
+		writer.WriteByte(definition.colorIndex);
+		writer.WriteFloat(definition.pivotOffset.x);
+		writer.WriteFloat(definition.pivotOffset.y);
+		writer.WriteInt(definition.numBlocks);
+
+		for (int i = 0; i < definition.numBlocks; i++)
+		{
+			writer.WriteInt(definition.blockOffsets[i].x);
+			writer.WriteInt(definition.blockOffsets[i].y);
+		}
+	}
+}
+
+std::shared_ptr<const PieceSet> PieceSet::ReadSnapshot(SnapshotReader& reader)
+{
+	if (reader.ReadBool())
+		return reader.IsValid() ? GetStandard() : nullptr;
+
+	std::shared_ptr<PieceSet> pieceSet = std::make_shared<PieceSet>(reader.ReadString(PIECE_SET_MAX_NAME_LENGTH));
+	int numPieces = reader.ReadInt(1, PIECE_SET_MAX_PIECES);
+
+	for (int type = 0; type < numPieces && reader.IsValid(); type++)
+	{
+		PieceDefinition definition = PieceDefinition();
+		definition.colorIndex = reader.ReadByte();
+		definition.pivotOffset.x = reader.ReadFloat();
+		definition.pivotOffset.y = reader.ReadFloat();
+		definition.numBlocks = reader.ReadInt(1, MAX_PIECE_BLOCKS);
+
+		for (int i = 0; i < definition.numBlocks; i++)
+		{
+			definition.blockOffsets[i].x = reader.ReadInt(-PIECE_SET_MAX_BLOCK_OFFSET, PIECE_SET_MAX_BLOCK_OFFSET);
+			definition.blockOffsets[i].y = reader.ReadInt(-PIECE_SET_MAX_BLOCK_OFFSET, PIECE_SET_MAX_BLOCK_OFFSET);
+		}
+
+		if (reader.IsValid() && !pieceSet->AddPiece(definition))
+			reader.Fail();
+	}
+
+	return reader.IsValid() ? pieceSet : nullptr;
+}
\ No newline at end of file
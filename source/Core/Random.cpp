@@ -0,0 +1,100 @@
+#include "Core/Random.h"
+
+static uint32_t RotateLeft(uint32_t x, int k)
+{
+	return (x << k) | (x >> (32 - k));
+}
+
+/// Returns the next value of a splitmix64 sequence, used to spread a seed over the whole state
+static uint64_t SplitMix64(uint64_t& x)
+{
+	uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+	return z ^ (z >> 31);
+}
+
+Random::Random(uint64_t seed)
+{
+	Seed(seed);
+}
+
+void Random::Seed(uint64_t seed)
+{
+	uint64_t first = SplitMix64(seed);
+	uint64_t second = SplitMix64(seed);
+
+	state[0] = (uint32_t)first;
+	state[1] = (uint32_t)(first >> 32);
+	state[2] = (uint32_t)second;
+	state[3] = (uint32_t)(second >> 32);
+}
+
+uint32_t Random::Next()
+{
+	uint32_t result = RotateLeft(state[1] * 5, 7) * 9;
+	uint32_t t = state[1] << 9;
+
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+
+	state[2] ^= t;
+	state[3] = RotateLeft(state[3], 11);
+
+	return result;
+}
+
+int Random::GetValue(int min, int max)
+{
+	uint32_t range = (uint32_t)max - (uint32_t)min + 1u;
+
+	//whole 32 bit range
+	if (range == 0)
+		return (int)Next();
+
+	//multiply and shift, rejecting the few values that would make some results more likely than others
+	uint64_t product = (uint64_t)Next() * range;
+	uint32_t low = (uint32_t)product;
+
+	if (low < range)
+	{
+		uint32_t threshold = (0u - range) % range;
+
+		while (low < threshold)
+		{
+			product = (uint64_t)Next() * range;
+			low = (uint32_t)product;
+		}
+	}
+
+	return (int)((uint32_t)min + (uint32_t)(product >> 32));
+}
+
+void Random::WriteSnapshot(SnapshotWriter& writer) const
+{
+	for (int i = 0; i < 4; i++)
+		writer.WriteUInt32(state[i]);
+}
+
+//An all zero state would only ever give zeros, and is never the result of seeding
+bool Random::ReadSnapshot(SnapshotReader& reader)
+{
+	uint32_t newState[4];
+
+	for (int i = 0; i < 4; i++)
+		newState[i] = reader.ReadUInt32();
+
+	if (!reader.IsValid() || (newState[0] | newState[1] | newState[2] | newState[3]) == 0)
+	{
+		reader.Fail();
+		return false;
+	}
+
+	for (int i = 0; i < 4; i++)
+		state[i] = newState[i];
+
+	return true;
+}
\ No newline at end of file
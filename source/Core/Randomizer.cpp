@@ -0,0 +1,197 @@
+#include <algorithm>
+
+#include "Core/Randomizer.h"
+
+const char* GetRandomizerTypeName(RandomizerType type)
+{
+	switch (type)
+	{
+		case RANDOMIZER_7_BAG:
+			return "7-BAG";
+		case RANDOMIZER_14_BAG:
+			return "14-BAG";
+		case RANDOMIZER_HISTORY:
+			return "HISTORY";
+		default:
+			return "UNKNOWN";
+	}
+}
+
+//The bags hold one or two copies of every piece in the set, which is 7 or 14 pieces for the standard set
+std::unique_ptr<Randomizer> Randomizer::Create(RandomizerType type, const PieceSet& pieceSet)
+{
+	switch (type)
+	{
+		case RANDOMIZER_14_BAG:
+			return std::make_unique<BagRandomizer>(pieceSet.GetNumPieces(), 2);
+		case RANDOMIZER_HISTORY:
+			return std::make_unique<HistoryRandomizer>(pieceSet.GetNumPieces(), pieceSet.IsStandard());
+		case RANDOMIZER_7_BAG:
+		default:
+			return std::make_unique<BagRandomizer>(pieceSet.GetNumPieces(), 1);
+	}
+}
+
+#pragma region Bag
+
+BagRandomizer::BagRandomizer(int numPieceTypes, int numCopies)
+{
+	this->numPieceTypes = numPieceTypes;
+	bagSize = numPieceTypes * std::clamp(numCopies, 1, BAG_RANDOMIZER_MAX_COPIES);
+	bagIndex = bagSize;
+
+	bagPieceTypes.resize(bagSize);
+}
+
+void BagRandomizer::RefillBag(Random& random)
+{
+	for (int i = 0; i < bagSize; i++)
+		bagPieceTypes[i] = i % numPieceTypes;
+
+	//shuffle in place
+	for (int i = 0; i < bagSize - 1; i++)
+		std::swap(bagPieceTypes[i], bagPieceTypes[random.GetValue(i, bagSize - 1)]);
+
+	bagIndex = 0;
+}
+
+void BagRandomizer::Reset()
+{
+	bagIndex = bagSize;
+}
+
+int BagRandomizer::Next(Random& random)
+{
+	//refill bag if empty
+	if (bagIndex == bagSize)
+		RefillBag(random);
+
+	return bagPieceTypes[bagIndex++];
+}
+
+//Only the pieces that are left in the bag matter
+void BagRandomizer::WriteSnapshot(SnapshotWriter& writer) const
+{
+	writer.WriteInt(bagSize - bagIndex);
+
+	for (int i = bagIndex; i < bagSize; i++)
+		writer.WriteByte((uint8_t)bagPieceTypes[i]);
+}
+
+bool BagRandomizer::ReadSnapshot(SnapshotReader& reader)
+{
+	int numPiecesLeft = reader.ReadInt(0, bagSize);
+
+	if (!reader.IsValid())
+		return false;
+
+	bagIndex = bagSize - numPiecesLeft;
+
+	for (int i = bagIndex; i < bagSize; i++)
+	{
+		uint8_t pieceType = reader.ReadByte();
+
+		if (pieceType >= numPieceTypes)
+			reader.Fail();
+
+		bagPieceTypes[i] = pieceType;
+	}
+
+	if (!reader.IsValid())
+	{
+		Reset();
+		return false;
+	}
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region History
+
+HistoryRandomizer::HistoryRandomizer(int numPieceTypes, bool isStandardPieceSet)
+{
+	this->numPieceTypes = numPieceTypes;
+	this->isStandardPieceSet = isStandardPieceSet;
+
+	Reset();
+}
+
+void HistoryRandomizer::Reset()
+{
+	if (isStandardPieceSet)
+	{
+		history[0] = PIECE_S;
+		history[1] = PIECE_Z;
+		history[2] = PIECE_S;
+		history[3] = PIECE_Z;
+	}
+	else
+	{
+		for (int i = 0; i < HISTORY_RANDOMIZER_SIZE; i++)
+			history[i] = -1;
+	}
+
+	isFirstPiece = true;
+}
+
+int HistoryRandomizer::Next(Random& random)
+{
+	const MainPieceType FIRST_PIECE_TYPES[] = { PIECE_I, PIECE_L, PIECE_J, PIECE_T };
+
+	int pieceType = 0;
+
+	if (isFirstPiece && isStandardPieceSet)
+	{
+		pieceType = FIRST_PIECE_TYPES[random.GetValue(0, 3)];
+		isFirstPiece = false;
+	}
+	else
+	{
+		isFirstPiece = false;
+
+		//reroll while the piece is in the history, keeping the last roll if all of them are
+		for (int roll = 0; roll < HISTORY_RANDOMIZER_ROLLS; roll++)
+		{
+			pieceType = random.GetValue(0, numPieceTypes - 1);
+
+			if (std::find(history, history + HISTORY_RANDOMIZER_SIZE, pieceType) == history + HISTORY_RANDOMIZER_SIZE)
+				break;
+		}
+	}
+
+	//newest piece goes to the front
+	for (int i = HISTORY_RANDOMIZER_SIZE - 1; i > 0; i--)
+		history[i] = history[i - 1];
+
+	history[0] = pieceType;
+
+	return pieceType;
+}
+
+void HistoryRandomizer::WriteSnapshot(SnapshotWriter& writer) const
+{
+	writer.WriteBool(isFirstPiece);
+
+	for (int i = 0; i < HISTORY_RANDOMIZER_SIZE; i++)
+		writer.WriteInt(history[i]);
+}
+
+bool HistoryRandomizer::ReadSnapshot(SnapshotReader& reader)
+{
+	isFirstPiece = reader.ReadBool();
+
+	for (int i = 0; i < HISTORY_RANDOMIZER_SIZE; i++)
+		history[i] = reader.ReadInt(-1, numPieceTypes - 1);
+
+	if (!reader.IsValid())
+	{
+		Reset();
+		return false;
+	}
+
+	return true;
+}
+
+#pragma endregion
\ No newline at end of file
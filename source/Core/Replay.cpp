@@ -0,0 +1,556 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+#include "Core/Replay.h"
+
+#pragma region Result
+
+ReplayResult ReplayResult::FromSimulation(const Simulation& simulation)
+{
+	ReplayResult result = ReplayResult();
+	result.ticksPlayed = simulation.GetTicksPlayed();
+	result.score = simulation.GetScore();
+	result.level = simulation.GetLevel();
+	result.totalLinesCleared = simulation.GetTotalLinesCleared();
+	result.gameOver = simulation.IsGameOver();
+	result.stateHash = simulation.GetStateHash();
+
+	return result;
+}
+
+bool ReplayResult::IsSameAs(const ReplayResult& result) const
+{
+	return ticksPlayed == result.ticksPlayed && score == result.score && level == result.level && totalLinesCleared == result.totalLinesCleared && gameOver == result.gameOver
+		&& stateHash == result.stateHash;
+}
+
+#pragma endregion
+
+#pragma region Replay
+
+const GameRules& Replay::GetRules() const
+{
+	return rules;
+}
+
+uint64_t Replay::GetSeed() const
+{
+	return seed;
+}
+
+int64_t Replay::GetNumTicks() const
+{
+	return numTicks;
+}
+
+int Replay::GetNumInputRuns() const
+{
+	return (int)inputRuns.size();
+}
+
+const ReplayInputRun& Replay::GetInputRun(int index) const
+{
+	return inputRuns[index];
+}
+
+int Replay::FindInputRun(int64_t tick) const
+{
+	return (int)(std::upper_bound(inputRunEndTicks.begin(), inputRunEndTicks.end(), tick) - inputRunEndTicks.begin());
+}
+
+int64_t Replay::GetInputRunStartTick(int index) const
+{
+	return (index > 0) ? inputRunEndTicks[index - 1] : 0;
+}
+
+int Replay::GetNumPlacementHashes() const
+{
+	return (int)placementHashes.size();
+}
+
+const ReplayPlacementHash& Replay::GetPlacementHash(int index) const
+{
+	return placementHashes[index];
+}
+
+int Replay::FindPlacementHash(int64_t tick) const
+{
+	auto isBefore = [](int64_t tick, const ReplayPlacementHash& placementHash)
+	{
+		return tick < placementHash.tick;
+	};
+
+	return (int)(std::upper_bound(placementHashes.begin(), placementHashes.end(), tick, isBefore) - placementHashes.begin());
+}
+
+int Replay::GetNumKeyframes() const
+{
+	return (int)keyframes.size();
+}
+
+const ReplayKeyframe& Replay::GetKeyframe(int index) const
+{
+	return keyframes[index];
+}
+
+const uint8_t* Replay::GetKeyframeData(const ReplayKeyframe& keyframe) const
+{
+	return keyframeData.data() + keyframe.dataOffset;
+}
+
+int Replay::FindKeyframe(int64_t tick) const
+{
+	auto isBefore = [](int64_t tick, const ReplayKeyframe& keyframe)
+	{
+		return tick < keyframe.tick;
+	};
+
+	return (int)(std::upper_bound(keyframes.begin(), keyframes.end(), tick, isBefore) - keyframes.begin()) - 1;
+}
+
+const ReplayResult& Replay::GetResult() const
+{
+	return result;
+}
+
+void Replay::Save(std::vector<uint8_t>& data) const
+{
+	SnapshotWriter writer = SnapshotWriter(data);
+
+	writer.WriteByte('K');
+	writer.WriteByte('R');
+	writer.WriteInt(REPLAY_VERSION);
+
+	rules.WriteSnapshot(writer);
+	writer.WriteUnsigned(seed);
+
+	//inputs
+	writer.WriteUnsigned(inputRuns.size());
+
+	for (const ReplayInputRun& inputRun : inputRuns)
+	{
+		writer.WriteUnsigned(inputRun.numTicks);
+		writer.WriteByte(inputRun.down);
+		writer.WriteByte(inputRun.pressed);
+	}
+
+	//placement hashes
+	writer.WriteUnsigned(placementHashes.size());
+
+	int64_t previousPlacementTick = 0;
+
+	for (const ReplayPlacementHash& placementHash : placementHashes)
+	{
+		writer.WriteUnsigned(placementHash.tick - previousPlacementTick);
+		writer.WriteUInt32(placementHash.hash);
+
+		previousPlacementTick = placementHash.tick;
+	}
+
+	//result
+	writer.WriteSigned(result.ticksPlayed);
+	writer.WriteInt(result.score);
+	writer.WriteInt(result.level);
+	writer.WriteInt(result.totalLinesCleared);
+	writer.WriteBool(result.gameOver);
+	writer.WriteUInt32((uint32_t)result.stateHash);
+	writer.WriteUInt32((uint32_t)(result.stateHash >> 32));
+
+	//keyframe index, then the snapshots
+	writer.WriteUnsigned(keyframes.size());
+
+	int64_t previousTick = 0;
+
+	for (const ReplayKeyframe& keyframe : keyframes)
+	{
+		writer.WriteUnsigned(keyframe.tick - previousTick);
+		writer.WriteUnsigned(keyframe.dataSize);
+
+		previousTick = keyframe.tick;
+	}
+
+	data.insert(data.end(), keyframeData.begin(), keyframeData.end());
+}
+
+bool Replay::Load(const uint8_t* data, size_t size)
+{
+	SnapshotReader reader = SnapshotReader(data, size);
+
+	if (reader.ReadByte() != 'K' || reader.ReadByte() != 'R' || reader.ReadInt(0, INT32_MAX) != REPLAY_VERSION)
+		return false;
+
+	GameRules replayRules = GameRules();
+
+	if (!replayRules.ReadSnapshot(reader))
+		return false;
+
+	uint64_t replaySeed = reader.ReadUnsigned();
+
+	//inputs, every run takes at least 3 bytes so an invalid amount can't allocate more than the data is long
+	uint64_t numInputRuns = reader.ReadUnsigned();
+
+	if (!reader.IsValid() || numInputRuns > size / 3)
+		return false;
+
+	std::vector<ReplayInputRun> replayInputRuns = std::vector<ReplayInputRun>((size_t)numInputRuns);
+	std::vector<int64_t> replayInputRunEndTicks = std::vector<int64_t>((size_t)numInputRuns);
+	int64_t replayNumTicks = 0;
+
+	for (size_t i = 0; i < replayInputRuns.size(); i++)
+	{
+		uint64_t numRunTicks = reader.ReadUnsigned();
+
+		if (numRunTicks == 0 || numRunTicks > std::numeric_limits<uint32_t>::max())
+			reader.Fail();
+
+		replayInputRuns[i].numTicks = (uint32_t)numRunTicks;
+		replayInputRuns[i].down = reader.ReadByte();
+		replayInputRuns[i].pressed = reader.ReadByte();
+
+		replayNumTicks += replayInputRuns[i].numTicks;
+		replayInputRunEndTicks[i] = replayNumTicks;
+	}
+
+	//placement hashes, at most one per tick
+	uint64_t numPlacementHashes = reader.ReadUnsigned();
+
+	if (!reader.IsValid() || numPlacementHashes > (uint64_t)replayNumTicks)
+		return false;
+
+	std::vector<ReplayPlacementHash> replayPlacementHashes = std::vector<ReplayPlacementHash>((size_t)numPlacementHashes);
+	int64_t previousPlacementTick = 0;
+
+	for (ReplayPlacementHash& placementHash : replayPlacementHashes)
+	{
+		uint64_t tickDelta = reader.ReadUnsigned();
+
+		if (tickDelta == 0 || tickDelta > (uint64_t)(replayNumTicks - previousPlacementTick))
+		{
+			reader.Fail();
+			break;
+		}
+
+		placementHash.tick = previousPlacementTick + (int64_t)tickDelta;
+		placementHash.hash = reader.ReadUInt32();
+
+		previousPlacementTick = placementHash.tick;
+	}
+
+	//result
+	ReplayResult replayResult = ReplayResult();
+	replayResult.ticksPlayed = reader.ReadSigned();
+	replayResult.score = reader.ReadInt(INT32_MIN, INT32_MAX);
+	replayResult.level = reader.ReadInt(1, INT32_MAX);
+	replayResult.totalLinesCleared = reader.ReadInt(0, INT32_MAX);
+	replayResult.gameOver = reader.ReadBool();
+	replayResult.stateHash = reader.ReadUInt32();
+	replayResult.stateHash |= (uint64_t)reader.ReadUInt32() << 32;
+
+	//keyframe index, every keyframe takes at least 2 bytes of it
+	uint64_t numKeyframes = reader.ReadUnsigned();
+
+	if (!reader.IsValid() || numKeyframes > size / 2)
+		return false;
+
+	std::vector<ReplayKeyframe> replayKeyframes = std::vector<ReplayKeyframe>((size_t)numKeyframes);
+	int64_t previousTick = 0;
+	uint64_t keyframeDataSize = 0;
+
+	for (ReplayKeyframe& keyframe : replayKeyframes)
+	{
+		uint64_t tickDelta = reader.ReadUnsigned();
+		uint64_t dataSize = reader.ReadUnsigned();
+
+		//keyframes are in order and within the replay, their snapshots within the data
+		if (tickDelta == 0 || tickDelta > (uint64_t)(replayNumTicks - previousTick) || dataSize > size)
+		{
+			reader.Fail();
+			break;
+		}
+
+		keyframe.tick = previousTick + (int64_t)tickDelta;
+		keyframe.dataOffset = (size_t)keyframeDataSize;
+		keyframe.dataSize = (size_t)dataSize;
+
+		previousTick = keyframe.tick;
+		keyframeDataSize += dataSize;
+	}
+
+	if (!reader.IsValid() || keyframeDataSize != size - reader.GetPosition())
+		return false;
+
+	rules = replayRules;
+	seed = replaySeed;
+	inputRuns = std::move(replayInputRuns);
+	inputRunEndTicks = std::move(replayInputRunEndTicks);
+	numTicks = replayNumTicks;
+	placementHashes = std::move(replayPlacementHashes);
+	result = replayResult;
+	keyframes = std::move(replayKeyframes);
+	keyframeData.assign(data + reader.GetPosition(), data + size);
+
+	return true;
+}
+
+bool Replay::SaveToFile(const std::string& path) const
+{
+	std::vector<uint8_t> data;
+	Save(data);
+
+	std::ofstream file = std::ofstream(path, std::ios::binary);
+
+	if (!file.is_open())
+		return false;
+
+	file.write((const char*)data.data(), (std::streamsize)data.size());
+
+	return file.good();
+}
+
+bool Replay::LoadFromFile(const std::string& path, std::string& error)
+{
+	std::ifstream file = std::ifstream(path, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		error = "could not open " + path;
+		return false;
+	}
+
+	std::vector<uint8_t> data = std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+	if (!Load(data.data(), data.size()))
+	{
+		error = path + " is not a valid replay of this version";
+		return false;
+	}
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region Recorder
+
+void ReplayRecorder::SetKeyframeIntervalSeconds(int seconds)
+{
+	keyframeIntervalSeconds = seconds;
+}
+
+void ReplayRecorder::Start(Simulation& simulation, const GameRules& rules, uint64_t seed)
+{
+	replay.rules = rules;
+	replay.seed = seed;
+	replay.inputRuns.clear();
+	replay.inputRunEndTicks.clear();
+	replay.numTicks = 0;
+	replay.placementHashes.clear();
+	replay.keyframes.clear();
+	replay.keyframeData.clear();
+
+	keyframeIntervalTicks = (int64_t)keyframeIntervalSeconds * rules.TickRate;
+
+	if (!simulation.GetRules().IsSameAs(rules))
+		simulation.SetRules(rules);
+
+	simulation.Start(seed);
+
+	replay.result = ReplayResult::FromSimulation(simulation);
+}
+
+unsigned int ReplayRecorder::Step(Simulation& simulation, const SimulationInput& input)
+{
+	//every SimulationInputAction fits in a byte
+	uint8_t down = (uint8_t)input.down;
+	uint8_t pressed = (uint8_t)input.pressed;
+
+	if (!replay.inputRuns.empty() && replay.inputRuns.back().down == down && replay.inputRuns.back().pressed == pressed
+		&& replay.inputRuns.back().numTicks < std::numeric_limits<uint32_t>::max())
+	{
+		replay.inputRuns.back().numTicks++;
+		replay.inputRunEndTicks.back()++;
+	}
+	else
+	{
+		replay.inputRuns.push_back(ReplayInputRun{ 1, down, pressed });
+		replay.inputRunEndTicks.push_back(replay.numTicks + 1);
+	}
+
+	replay.numTicks++;
+
+	unsigned int events = simulation.Step(SimulationInput(down, pressed));
+
+	if (events & EVENT_PIECE_PLACED)
+		replay.placementHashes.push_back(ReplayPlacementHash{ replay.numTicks, (uint32_t)simulation.GetZobristHash() });
+
+	//keyframes are taken after the tick, restoring one continues with the next tick
+	if (keyframeIntervalTicks > 0 && replay.numTicks % keyframeIntervalTicks == 0 && !simulation.IsGameOver())
+	{
+		ReplayKeyframe keyframe = ReplayKeyframe();
+		keyframe.tick = replay.numTicks;
+		keyframe.dataOffset = replay.keyframeData.size();
+
+		simulation.SaveSnapshot(replay.keyframeData);
+
+		keyframe.dataSize = replay.keyframeData.size() - keyframe.dataOffset;
+		replay.keyframes.push_back(keyframe);
+	}
+
+	return events;
+}
+
+void ReplayRecorder::Finish(const Simulation& simulation)
+{
+	replay.result = ReplayResult::FromSimulation(simulation);
+}
+
+const Replay& ReplayRecorder::GetReplay() const
+{
+	return replay;
+}
+
+#pragma endregion
+
+#pragma region Player
+
+void ReplayPlayer::Start(Simulation& simulation)
+{
+	if (!simulation.GetRules().IsSameAs(replay->GetRules()))
+		simulation.SetRules(replay->GetRules());
+
+	simulation.Start(replay->GetSeed());
+
+	SetTick(0);
+	desyncTick = -1;
+}
+
+void ReplayPlayer::SetTick(int64_t tick)
+{
+	this->tick = tick;
+
+	runIndex = replay->FindInputRun(tick);
+	runTick = (uint32_t)(tick - replay->GetInputRunStartTick(runIndex));
+
+	placementHashIndex = replay->FindPlacementHash(tick);
+}
+
+bool ReplayPlayer::Seek(Simulation& simulation, int64_t tick)
+{
+	tick = std::clamp(tick, (int64_t)0, replay->GetNumTicks());
+
+	int keyframeIndex = replay->FindKeyframe(tick);
+	int64_t keyframeTick = (keyframeIndex >= 0) ? replay->GetKeyframe(keyframeIndex).tick : 0;
+
+	bool isLoaded = true;
+
+	//going back, or further forward than the keyframe, restarts from the keyframe
+	if (tick < this->tick || keyframeTick > this->tick)
+	{
+		if (keyframeIndex >= 0)
+		{
+			const ReplayKeyframe& keyframe = replay->GetKeyframe(keyframeIndex);
+			isLoaded = simulation.LoadSnapshot(replay->GetKeyframeData(keyframe), keyframe.dataSize);
+		}
+
+		if (keyframeIndex >= 0 && isLoaded)
+			SetTick(keyframeTick);
+		else
+			Start(simulation);
+	}
+
+	while (this->tick < tick)
+		Step(simulation);
+
+	return isLoaded;
+}
+
+bool ReplayPlayer::IsAtEnd() const
+{
+	return runIndex >= replay->GetNumInputRuns();
+}
+
+int64_t ReplayPlayer::GetTick() const
+{
+	return tick;
+}
+
+SimulationInput ReplayPlayer::NextInput()
+{
+	if (IsAtEnd())
+		return SimulationInput();
+
+	const ReplayInputRun& inputRun = replay->GetInputRun(runIndex);
+
+	tick++;
+	runTick++;
+
+	if (runTick == inputRun.numTicks)
+	{
+		runIndex++;
+		runTick = 0;
+	}
+
+	return SimulationInput(inputRun.down, inputRun.pressed);
+}
+
+unsigned int ReplayPlayer::Step(Simulation& simulation)
+{
+	if (IsAtEnd())
+		return EVENT_NONE;
+
+	unsigned int events = simulation.Step(NextInput());
+
+	//a placement has to happen at the tick of the next hash and end up with that hash
+	bool isPlacementTick = placementHashIndex < replay->GetNumPlacementHashes() && replay->GetPlacementHash(placementHashIndex).tick == tick;
+	bool isPlaced = (events & EVENT_PIECE_PLACED) != 0;
+
+	if (isPlacementTick != isPlaced || (isPlaced && replay->GetPlacementHash(placementHashIndex).hash != (uint32_t)simulation.GetZobristHash()))
+	{
+		if (desyncTick < 0)
+			desyncTick = tick;
+	}
+
+	if (isPlacementTick)
+		placementHashIndex++;
+
+	return events;
+}
+
+int64_t ReplayPlayer::GetDesyncTick() const
+{
+	return desyncTick;
+}
+
+bool ReplayPlayer::PlayToEnd(Simulation& simulation)
+{
+	while (!IsAtEnd())
+		Step(simulation);
+
+	return ReplayResult::FromSimulation(simulation).IsSameAs(replay->GetResult());
+}
+
+#pragma endregion
+
+#pragma region Files
+
+void FindReplayFiles(const std::string& path, std::vector<std::string>& paths)
+{
+	std::error_code errorCode;
+
+	if (!std::filesystem::is_directory(path, errorCode))
+	{
+		paths.push_back(path);
+		return;
+	}
+
+	for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(path, errorCode))
+	{
+		if (entry.is_regular_file(errorCode) && entry.path().extension() == REPLAY_FILE_EXTENSION)
+			paths.push_back(entry.path().string());
+	}
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,521 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#include "Core/ReplayArchive.h"
+
+//Columns are stored as they are in memory, little endian, so they can be read in place
+const bool IS_ARCHIVE_ENDIANNESS_NATIVE = std::endian::native == std::endian::little;
+
+//Every column starts at a multiple of this, so the columns can be read in place
+const size_t ARCHIVE_COLUMN_ALIGNMENT = 8;
+
+//Start of an archive file, followed by the columns
+struct ReplayArchiveHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint64_t numGames;
+	uint64_t numPlacements;
+	uint64_t numLevelRuns;
+	uint64_t columnOffsets[NUM_ARCHIVE_COLUMNS];
+};
+
+enum ReplayArchiveTable
+{
+	ARCHIVE_TABLE_GAMES,
+	ARCHIVE_TABLE_PLACEMENTS,
+	ARCHIVE_TABLE_LEVEL_RUNS
+};
+
+struct ReplayArchiveColumnLayout
+{
+	ReplayArchiveTable table;
+	size_t valueSize;
+};
+
+//Table and value size of every ReplayArchiveColumn
+const ReplayArchiveColumnLayout ARCHIVE_COLUMN_LAYOUTS[NUM_ARCHIVE_COLUMNS] = {
+	{ ARCHIVE_TABLE_GAMES, sizeof(uint64_t) },
+	{ ARCHIVE_TABLE_GAMES, sizeof(uint64_t) },
+	{ ARCHIVE_TABLE_GAMES, sizeof(uint32_t) },
+	{ ARCHIVE_TABLE_GAMES, sizeof(uint64_t) },
+	{ ARCHIVE_TABLE_GAMES, sizeof(uint32_t) },
+	{ ARCHIVE_TABLE_GAMES, sizeof(int32_t) },
+	{ ARCHIVE_TABLE_GAMES, sizeof(int32_t) },
+	{ ARCHIVE_TABLE_GAMES, sizeof(int32_t) },
+	{ ARCHIVE_TABLE_GAMES, sizeof(uint32_t) },
+	{ ARCHIVE_TABLE_GAMES, sizeof(uint8_t) },
+
+	{ ARCHIVE_TABLE_PLACEMENTS, sizeof(uint32_t) },
+	{ ARCHIVE_TABLE_PLACEMENTS, sizeof(uint16_t) },
+	{ ARCHIVE_TABLE_PLACEMENTS, sizeof(uint16_t) },
+	{ ARCHIVE_TABLE_PLACEMENTS, sizeof(uint8_t) },
+	{ ARCHIVE_TABLE_PLACEMENTS, sizeof(uint8_t) },
+	{ ARCHIVE_TABLE_PLACEMENTS, sizeof(int8_t) },
+	{ ARCHIVE_TABLE_PLACEMENTS, sizeof(uint8_t) },
+
+	{ ARCHIVE_TABLE_LEVEL_RUNS, sizeof(uint32_t) },
+	{ ARCHIVE_TABLE_LEVEL_RUNS, sizeof(uint32_t) },
+	{ ARCHIVE_TABLE_LEVEL_RUNS, sizeof(uint64_t) },
+	{ ARCHIVE_TABLE_LEVEL_RUNS, sizeof(uint32_t) }
+};
+
+#pragma region Builder
+
+void ReplayArchiveBuilder::AddPlacement(const Simulation& simulation, int64_t tick)
+{
+	const PiecePlacement& placement = simulation.GetLastPlacement();
+	const Board& board = simulation.GetBoard();
+
+	int stackHeight = 0;
+
+	for (int x = 0; x < board.GetSize().x; x++)
+		stackHeight = std::max(stackHeight, board.GetColumnHeight(x));
+
+	int left = board.GetSize().x;
+
+	for (int i = 0; i < placement.piece.numBlocks; i++)
+		left = std::min(left, placement.position.x + placement.piece.blockOffsets[i].x);
+
+	placementTicks.push_back((uint32_t)std::min(tick, (int64_t)std::numeric_limits<uint32_t>::max()));
+	placementLevels.push_back((uint16_t)std::min(simulation.GetLevel(), (int)std::numeric_limits<uint16_t>::max()));
+	placementStackHeights.push_back((uint16_t)std::min(stackHeight, (int)std::numeric_limits<uint16_t>::max()));
+	placementPieceTypes.push_back((uint8_t)placement.piece.type);
+	placementRotations.push_back((uint8_t)placement.piece.rotation);
+	placementColumns.push_back((int8_t)left);
+	placementLinesCleared.push_back((uint8_t)placement.linesCleared);
+}
+
+void ReplayArchiveBuilder::RemovePlacementsFrom(size_t firstPlacement)
+{
+	placementTicks.resize(firstPlacement);
+	placementLevels.resize(firstPlacement);
+	placementStackHeights.resize(firstPlacement);
+	placementPieceTypes.resize(firstPlacement);
+	placementRotations.resize(firstPlacement);
+	placementColumns.resize(firstPlacement);
+	placementLinesCleared.resize(firstPlacement);
+}
+
+bool ReplayArchiveBuilder::AddReplay(const Replay& replay)
+{
+	Simulation simulation = Simulation(replay.GetRules());
+	ReplayPlayer player = ReplayPlayer(replay);
+	player.Start(simulation);
+
+	size_t firstPlacement = placementTicks.size();
+
+	while (!player.IsAtEnd())
+	{
+		if (player.Step(simulation) & EVENT_PIECE_PLACED)
+			AddPlacement(simulation, player.GetTick());
+	}
+
+	size_t numPlacements = placementTicks.size() - firstPlacement;
+
+	if (player.GetDesyncTick() >= 0 || !ReplayResult::FromSimulation(simulation).IsSameAs(replay.GetResult())
+		|| numPlacements > std::numeric_limits<uint32_t>::max())
+	{
+		RemovePlacementsFrom(firstPlacement);
+		return false;
+	}
+
+	//columns with empty cells below their top
+	const Board& board = simulation.GetBoard();
+	uint32_t holeColumns = 0;
+
+	for (int x = 0; x < board.GetSize().x; x++)
+	{
+		for (int y = board.GetColumnTop(x) + 1; y < board.GetSize().y; y++)
+		{
+			if ((board.GetRowMask(y) & (1u << x)) == 0)
+			{
+				holeColumns |= 1u << x;
+				break;
+			}
+		}
+	}
+
+	gameSeeds.push_back(replay.GetSeed());
+	gameFirstPlacements.push_back(firstPlacement);
+	gameNumPlacements.push_back((uint32_t)numPlacements);
+	gameTicksPlayed.push_back((uint64_t)simulation.GetTicksPlayed());
+	gameTickRates.push_back((uint32_t)replay.GetRules().TickRate);
+	gameScores.push_back(simulation.GetScore());
+	gameLevels.push_back(simulation.GetLevel());
+	gameLinesCleared.push_back(simulation.GetTotalLinesCleared());
+	gameHoleColumns.push_back(holeColumns);
+	gameOver.push_back(simulation.IsGameOver() ? 1 : 0);
+
+	return true;
+}
+
+void ReplayArchiveBuilder::Append(const ReplayArchiveBuilder& other)
+{
+	size_t placementOffset = placementTicks.size();
+
+	for (uint64_t firstPlacement : other.gameFirstPlacements)
+		gameFirstPlacements.push_back(placementOffset + firstPlacement);
+
+	gameSeeds.insert(gameSeeds.end(), other.gameSeeds.begin(), other.gameSeeds.end());
+	gameNumPlacements.insert(gameNumPlacements.end(), other.gameNumPlacements.begin(), other.gameNumPlacements.end());
+	gameTicksPlayed.insert(gameTicksPlayed.end(), other.gameTicksPlayed.begin(), other.gameTicksPlayed.end());
+	gameTickRates.insert(gameTickRates.end(), other.gameTickRates.begin(), other.gameTickRates.end());
+	gameScores.insert(gameScores.end(), other.gameScores.begin(), other.gameScores.end());
+	gameLevels.insert(gameLevels.end(), other.gameLevels.begin(), other.gameLevels.end());
+	gameLinesCleared.insert(gameLinesCleared.end(), other.gameLinesCleared.begin(), other.gameLinesCleared.end());
+	gameHoleColumns.insert(gameHoleColumns.end(), other.gameHoleColumns.begin(), other.gameHoleColumns.end());
+	gameOver.insert(gameOver.end(), other.gameOver.begin(), other.gameOver.end());
+
+	placementTicks.insert(placementTicks.end(), other.placementTicks.begin(), other.placementTicks.end());
+	placementLevels.insert(placementLevels.end(), other.placementLevels.begin(), other.placementLevels.end());
+	placementStackHeights.insert(placementStackHeights.end(), other.placementStackHeights.begin(), other.placementStackHeights.end());
+	placementPieceTypes.insert(placementPieceTypes.end(), other.placementPieceTypes.begin(), other.placementPieceTypes.end());
+	placementRotations.insert(placementRotations.end(), other.placementRotations.begin(), other.placementRotations.end());
+	placementColumns.insert(placementColumns.end(), other.placementColumns.begin(), other.placementColumns.end());
+	placementLinesCleared.insert(placementLinesCleared.end(), other.placementLinesCleared.begin(), other.placementLinesCleared.end());
+}
+
+size_t ReplayArchiveBuilder::GetNumGames() const
+{
+	return gameSeeds.size();
+}
+
+size_t ReplayArchiveBuilder::GetNumPlacements() const
+{
+	return placementTicks.size();
+}
+
+bool ReplayArchiveBuilder::SaveToFile(const std::string& path) const
+{
+	if (!IS_ARCHIVE_ENDIANNESS_NATIVE)
+		return false;
+
+	//level index, a run for every level of every game, games reach their levels in order
+	std::vector<uint32_t> runLevels;
+	std::vector<uint32_t> runGames;
+	std::vector<uint64_t> runFirstPlacements;
+	std::vector<uint32_t> runNumPlacements;
+
+	for (size_t game = 0; game < gameSeeds.size(); game++)
+	{
+		uint64_t endPlacement = gameFirstPlacements[game] + gameNumPlacements[game];
+
+		for (uint64_t placement = gameFirstPlacements[game]; placement < endPlacement; placement++)
+		{
+			if (placement == gameFirstPlacements[game] || placementLevels[placement] != placementLevels[placement - 1])
+			{
+				runLevels.push_back(placementLevels[placement]);
+				runGames.push_back((uint32_t)game);
+				runFirstPlacements.push_back(placement);
+				runNumPlacements.push_back(0);
+			}
+
+			runNumPlacements.back()++;
+		}
+	}
+
+	std::vector<size_t> runOrder = std::vector<size_t>(runLevels.size());
+
+	for (size_t i = 0; i < runOrder.size(); i++)
+		runOrder[i] = i;
+
+	std::stable_sort(runOrder.begin(), runOrder.end(), [&](size_t a, size_t b) { return runLevels[a] < runLevels[b]; });
+
+	auto reorder = [&](auto& values)
+	{
+		auto ordered = values;
+
+		for (size_t i = 0; i < runOrder.size(); i++)
+			ordered[i] = values[runOrder[i]];
+
+		values = std::move(ordered);
+	};
+
+	reorder(runLevels);
+	reorder(runGames);
+	reorder(runFirstPlacements);
+	reorder(runNumPlacements);
+
+	//bytes of every column, in ReplayArchiveColumn order
+	struct ColumnData
+	{
+		const void* values;
+		size_t size;
+	};
+
+	auto columnData = [](const auto& values)
+	{
+		return ColumnData{ values.data(), values.size() * sizeof(values[0]) };
+	};
+
+	const ColumnData columns[NUM_ARCHIVE_COLUMNS] = {
+		columnData(gameSeeds), columnData(gameFirstPlacements), columnData(gameNumPlacements), columnData(gameTicksPlayed), columnData(gameTickRates),
+		columnData(gameScores), columnData(gameLevels), columnData(gameLinesCleared), columnData(gameHoleColumns), columnData(gameOver),
+		columnData(placementTicks), columnData(placementLevels), columnData(placementStackHeights), columnData(placementPieceTypes),
+		columnData(placementRotations), columnData(placementColumns), columnData(placementLinesCleared),
+		columnData(runLevels), columnData(runGames), columnData(runFirstPlacements), columnData(runNumPlacements)
+	};
+
+	ReplayArchiveHeader header = ReplayArchiveHeader();
+	std::memcpy(header.magic, "KARC", 4);
+	header.version = REPLAY_ARCHIVE_VERSION;
+	header.numGames = gameSeeds.size();
+	header.numPlacements = placementTicks.size();
+	header.numLevelRuns = runLevels.size();
+
+	uint64_t offset = sizeof(ReplayArchiveHeader);
+
+	for (int column = 0; column < NUM_ARCHIVE_COLUMNS; column++)
+	{
+		header.columnOffsets[column] = offset;
+		offset += (columns[column].size + ARCHIVE_COLUMN_ALIGNMENT - 1) / ARCHIVE_COLUMN_ALIGNMENT * ARCHIVE_COLUMN_ALIGNMENT;
+	}
+
+	std::ofstream file = std::ofstream(path, std::ios::binary);
+
+	if (!file.is_open())
+		return false;
+
+	const char padding[ARCHIVE_COLUMN_ALIGNMENT] = {};
+
+	file.write((const char*)&header, sizeof(header));
+
+	for (const ColumnData& column : columns)
+	{
+		file.write((const char*)column.values, (std::streamsize)column.size);
+		file.write(padding, (std::streamsize)((ARCHIVE_COLUMN_ALIGNMENT - column.size % ARCHIVE_COLUMN_ALIGNMENT) % ARCHIVE_COLUMN_ALIGNMENT));
+	}
+
+	return file.good();
+}
+
+#pragma endregion
+
+#pragma region Archive
+
+bool ReplayArchive::Open(const std::string& path, std::string& error)
+{
+	Close();
+
+	if (!IS_ARCHIVE_ENDIANNESS_NATIVE)
+	{
+		error = "Replay archives can only be read on little endian machines";
+		return false;
+	}
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	LARGE_INTEGER fileSize = LARGE_INTEGER();
+
+	if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize))
+	{
+		if (file != INVALID_HANDLE_VALUE)
+			CloseHandle(file);
+
+		error = "Could not open " + path;
+		return false;
+	}
+
+	//the view keeps the file mapped once the handles are closed
+	HANDLE mapping = (fileSize.QuadPart >= (LONGLONG)sizeof(ReplayArchiveHeader)) ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+	const void* view = (mapping != nullptr) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+	if (mapping != nullptr)
+		CloseHandle(mapping);
+
+	CloseHandle(file);
+
+	if (view == nullptr)
+	{
+		error = path + " is not a valid replay archive";
+		return false;
+	}
+
+	size = (size_t)fileSize.QuadPart;
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	struct stat fileStat;
+
+	if (file < 0 || fstat(file, &fileStat) != 0)
+	{
+		if (file >= 0)
+			close(file);
+
+		error = "Could not open " + path;
+		return false;
+	}
+
+	//the mapping stays once the file is closed
+	void* view = ((size_t)fileStat.st_size >= sizeof(ReplayArchiveHeader)) ? mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_SHARED, file, 0) : MAP_FAILED;
+	close(file);
+
+	if (view == MAP_FAILED)
+	{
+		error = path + " is not a valid replay archive";
+		return false;
+	}
+
+	size = (size_t)fileStat.st_size;
+#endif
+
+	data = (const uint8_t*)view;
+
+	if (!MapColumns())
+	{
+		error = path + " is not a valid replay archive of this version";
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+//Points the columns into the mapped file, after checking that they and every index in them are within it
+bool ReplayArchive::MapColumns()
+{
+	ReplayArchiveHeader header;
+	std::memcpy(&header, data, sizeof(header));
+
+	if (std::memcmp(header.magic, "KARC", 4) != 0 || header.version != REPLAY_ARCHIVE_VERSION
+		|| header.numGames > size || header.numPlacements > size || header.numLevelRuns > size)
+		return false;
+
+	const void* columns[NUM_ARCHIVE_COLUMNS];
+
+	for (int column = 0; column < NUM_ARCHIVE_COLUMNS; column++)
+	{
+		const ReplayArchiveColumnLayout& layout = ARCHIVE_COLUMN_LAYOUTS[column];
+		uint64_t offset = header.columnOffsets[column];
+
+		uint64_t numValues = header.numLevelRuns;
+
+		if (layout.table == ARCHIVE_TABLE_GAMES)
+			numValues = header.numGames;
+		else if (layout.table == ARCHIVE_TABLE_PLACEMENTS)
+			numValues = header.numPlacements;
+
+		if (offset % ARCHIVE_COLUMN_ALIGNMENT != 0 || offset < sizeof(ReplayArchiveHeader) || offset > size || numValues * layout.valueSize > size - offset)
+			return false;
+
+		columns[column] = data + offset;
+	}
+
+	numGames = (size_t)header.numGames;
+	numPlacements = (size_t)header.numPlacements;
+	numLevelRuns = (size_t)header.numLevelRuns;
+
+	games.seeds = (const uint64_t*)columns[ARCHIVE_GAME_SEEDS];
+	games.firstPlacements = (const uint64_t*)columns[ARCHIVE_GAME_FIRST_PLACEMENTS];
+	games.numPlacements = (const uint32_t*)columns[ARCHIVE_GAME_NUM_PLACEMENTS];
+	games.ticksPlayed = (const uint64_t*)columns[ARCHIVE_GAME_TICKS_PLAYED];
+	games.tickRates = (const uint32_t*)columns[ARCHIVE_GAME_TICK_RATES];
+	games.scores = (const int32_t*)columns[ARCHIVE_GAME_SCORES];
+	games.levels = (const int32_t*)columns[ARCHIVE_GAME_LEVELS];
+	games.linesCleared = (const int32_t*)columns[ARCHIVE_GAME_LINES_CLEARED];
+	games.holeColumns = (const uint32_t*)columns[ARCHIVE_GAME_HOLE_COLUMNS];
+	games.gameOver = (const uint8_t*)columns[ARCHIVE_GAME_OVER];
+
+	placements.ticks = (const uint32_t*)columns[ARCHIVE_PLACEMENT_TICKS];
+	placements.levels = (const uint16_t*)columns[ARCHIVE_PLACEMENT_LEVELS];
+	placements.stackHeights = (const uint16_t*)columns[ARCHIVE_PLACEMENT_STACK_HEIGHTS];
+	placements.pieceTypes = (const uint8_t*)columns[ARCHIVE_PLACEMENT_PIECE_TYPES];
+	placements.rotations = (const uint8_t*)columns[ARCHIVE_PLACEMENT_ROTATIONS];
+	placements.columns = (const int8_t*)columns[ARCHIVE_PLACEMENT_COLUMNS];
+	placements.linesCleared = (const uint8_t*)columns[ARCHIVE_PLACEMENT_LINES_CLEARED];
+
+	levelRuns.levels = (const uint32_t*)columns[ARCHIVE_LEVEL_RUN_LEVELS];
+	levelRuns.games = (const uint32_t*)columns[ARCHIVE_LEVEL_RUN_GAMES];
+	levelRuns.firstPlacements = (const uint64_t*)columns[ARCHIVE_LEVEL_RUN_FIRST_PLACEMENTS];
+	levelRuns.numPlacements = (const uint32_t*)columns[ARCHIVE_LEVEL_RUN_NUM_PLACEMENTS];
+
+	//queries index placements with these without checking them
+	for (size_t game = 0; game < numGames; game++)
+	{
+		if (games.firstPlacements[game] > numPlacements || games.numPlacements[game] > numPlacements - games.firstPlacements[game] || games.tickRates[game] == 0)
+			return false;
+	}
+
+	for (size_t run = 0; run < numLevelRuns; run++)
+	{
+		//runs are never empty
+		if (levelRuns.games[run] >= numGames || levelRuns.firstPlacements[run] >= numPlacements || levelRuns.numPlacements[run] == 0
+			|| levelRuns.numPlacements[run] > numPlacements - levelRuns.firstPlacements[run]
+			|| (run > 0 && levelRuns.levels[run] < levelRuns.levels[run - 1]))
+			return false;
+	}
+
+	return true;
+}
+
+void ReplayArchive::Close()
+{
+	if (data != nullptr)
+	{
+#if defined(_WIN32)
+		UnmapViewOfFile(data);
+#else
+		munmap((void*)data, size);
+#endif
+	}
+
+	data = nullptr;
+	size = 0;
+	numGames = 0;
+	numPlacements = 0;
+	numLevelRuns = 0;
+}
+
+size_t ReplayArchive::GetNumGames() const
+{
+	return numGames;
+}
+
+size_t ReplayArchive::GetNumPlacements() const
+{
+	return numPlacements;
+}
+
+size_t ReplayArchive::GetNumLevelRuns() const
+{
+	return numLevelRuns;
+}
+
+const ReplayArchiveGames& ReplayArchive::GetGames() const
+{
+	return games;
+}
+
+const ReplayArchivePlacements& ReplayArchive::GetPlacements() const
+{
+	return placements;
+}
+
+const ReplayArchiveLevelRuns& ReplayArchive::GetLevelRuns() const
+{
+	return levelRuns;
+}
+
+size_t ReplayArchive::FindLevelRun(int level) const
+{
+	if (level <= 0)
+		return 0;
+
+	return (size_t)(std::lower_bound(levelRuns.levels, levelRuns.levels + numLevelRuns, (uint32_t)level) - levelRuns.levels);
+}
+
+#pragma endregion
\ No newline at end of file
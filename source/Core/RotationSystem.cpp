@@ -0,0 +1,61 @@
+#include "Core/RotationSystem.h"
+
+const char* GetRotationSystemTypeName(RotationSystemType type)
+{
+	switch (type)
+	{
+		case ROTATION_CLASSIC:
+			return "CLASSIC";
+		case ROTATION_SRS:
+			return "SRS";
+		case ROTATION_ARS:
+			return "ARS";
+		default:
+			return "UNKNOWN";
+	}
+}
+
+bool KickPieceRotation(const Board& board, RotationSystemType type, const PieceSet& pieceSet, int pieceType, int fromRotation, int toRotation, Vector2Int& position)
+{
+	const PieceShape& shape = pieceSet.GetShape(pieceType, toRotation);
+	const RotationKicks& kicks = GetRotationKicks(type, pieceSet, pieceType, fromRotation, toRotation);
+
+	const Vector2Int* offsets = kicks.offsets;
+	Vector2Int scaledOffsets[MAX_ROTATION_KICKS];
+
+	//The classic kicks move the piece by as many columns as the rotated piece would overlap if it had been rotated without being moved at all
+	if (kicks.isScaledByBlockedWidth)
+	{
+		uint32_t blockedColumns = board.GetBlockedColumns(shape.mask, position);
+
+		//rotates in place
+		if (blockedColumns == 0)
+			return true;
+
+		int leftBlockedColumn = 0;
+		int rightBlockedColumn = 31;
+
+		while ((blockedColumns & (1u << leftBlockedColumn)) == 0)
+			leftBlockedColumn++;
+
+		while ((blockedColumns & (1u << rightBlockedColumn)) == 0)
+			rightBlockedColumn--;
+
+		int blockedWidth = rightBlockedColumn - leftBlockedColumn + 1;
+
+		for (int i = 0; i < kicks.numOffsets; i++)
+			scaledOffsets[i] = Vector2Int{ kicks.offsets[i].x * blockedWidth, kicks.offsets[i].y };
+
+		offsets = scaledOffsets;
+	}
+
+	//every kick is tested against the same lines of the board at once, the first one the piece fits at is taken
+	int kickIndex = board.FindFittingOffset(shape.mask, position, offsets, kicks.numOffsets);
+
+	if (kickIndex < 0)
+		return false;
+
+	position = Vector2Int{ position.x + offsets[kickIndex].x, position.y + offsets[kickIndex].y };
+
+	return true;
+}
\ No newline at end of file
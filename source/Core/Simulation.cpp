@@ -0,0 +1,954 @@
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+#include "Core/Simulation.h"
+#include "Core/PieceTables.h"
+
+Simulation::Simulation(GameRules rules)
+{
+	SetRules(rules);
+}
+
+void Simulation::SetRules(GameRules rules)
+{
+	this->rules = rules;
+
+	upAndComingPieceTypes.resize(rules.NumUpAndComingPieces);
+	upAndComingPiecesStart = 0;
+
+	randomizer = Randomizer::Create(rules.Randomizer, *rules.Pieces);
+
+	board.SetSize(rules.GridSize);
+
+	for (int i = 0; i < GRAVITY_TABLE_LEVELS; i++)
+		gravityTable[i] = CellsPerSecondToCellsPerTick(GetGravityCellsPerSecond(rules.Gravity, i + 1));
+
+	UpdateLevelTimings();
+
+	ClearHistory();
+}
+
+const GameRules& Simulation::GetRules() const
+{
+	return rules;
+}
+
+#pragma region Gameplay
+
+void Simulation::Start(uint64_t seed)
+{
+	//random
+	this->seed = seed;
+	random.Seed(seed);
+	randomizer->Reset();
+
+	//main
+	gameOver = false;
+	isClearingLines = false;
+	numClearingLines = 0;
+	lastPlacement = PiecePlacement();
+
+	//timers
+	gravityPieceCells = 0;
+	movementPieceTickTime = 0;
+	lineClearingTickTime = 0;
+
+	//statistics
+	ticksPlayed = 0;
+	totalLinesCleared = 0;
+	score = 0;
+	level = 1;
+
+	UpdateLevelTimings();
+
+	//pieces
+	holdingPiece = Piece(0); //no piece
+	hasSwitchedPiece = false;
+
+	upAndComingPiecesStart = 0;
+
+	for (int i = 0; i < rules.NumUpAndComingPieces; i++)
+		upAndComingPieceTypes[i] = randomizer->Next(random);
+
+	NextPiece();
+
+	board.Clear();
+
+	ClearHistory();
+}
+
+//Durations are only converted once per level, each tick then only adds integers
+int64_t Simulation::SecondsToTickTime(float seconds) const
+{
+	return std::max((int64_t)std::llround((double)seconds * rules.TickRate * TICK_TIME_SCALE), (int64_t)1);
+}
+
+//Rounded up, so a piece never takes longer to fall a cell than it should
+int64_t Simulation::CellsPerSecondToCellsPerTick(double cellsPerSecond) const
+{
+	//20G drops the piece through the whole grid
+	if (cellsPerSecond >= MAX_GRAVITY_CELLS_PER_SECOND)
+		return (int64_t)rules.GridSize.y * GRAVITY_CELL_SCALE;
+
+	return (int64_t)std::ceil(cellsPerSecond / rules.TickRate * (double)GRAVITY_CELL_SCALE);
+}
+
+void Simulation::UpdateLevelTimings()
+{
+	gravityCellsPerTick = gravityTable[std::clamp(level, 1, GRAVITY_TABLE_LEVELS) - 1];
+	softDropCellsPerTick = CellsPerSecondToCellsPerTick(SOFT_DROP_CELLS_PER_SECOND);
+	movePieceTickTime = SecondsToTickTime(1.0f / 10.0f);
+	lineClearTickTime = SecondsToTickTime(std::max(1.0f - 0.1f * level, 0.1f));
+}
+
+unsigned int Simulation::Step(const SimulationInput& input)
+{
+	events = EVENT_NONE;
+
+	if (gameOver)
+		return events;
+
+	//going on from the last entry makes the game go on past the history again, the entry was the game as it is now
+	if (historyIndex == (int)history.size() - 1)
+	{
+		history.pop_back();
+		historyIndex = (int)history.size();
+	}
+
+	ticksPlayed++;
+
+	if (isClearingLines)
+	{
+		lineClearingTickTime += TICK_TIME_SCALE;
+
+		//Wait lineClearTickTime for anim and then clear line
+		if (lineClearingTickTime >= lineClearTickTime)
+		{
+			//Clear lines
+			int numClearedLines = numClearingLines;
+
+			for (int i = 0; i < numClearingLines; i++)
+				board.ClearLine(clearingLines[i]);
+
+			//lines are cleared from the top down, every line below the last one stayed where it was
+			if (recordHistory)
+				UpdateHistoryLines(clearingLines[numClearingLines - 1]);
+
+			totalLinesCleared += numClearedLines;
+
+			switch (numClearedLines)
+			{
+				//single
+				case 1:
+					score += 100 * level;
+					break;
+				//double
+				case 2:
+					score += 300 * level;
+					break;
+				//triple
+				case 3:
+					score += 500 * level;
+					break;
+				//tetris
+				case 4:
+					score += 800 * level;
+					break;
+			}
+
+			isClearingLines = false;
+			events |= EVENT_LINES_CLEARED;
+
+			//Level up every total 10 lines cleared
+			if (totalLinesCleared / 10 != (totalLinesCleared - numClearedLines) / 10)
+			{
+				level++;
+				events |= EVENT_LEVEL_UP;
+				UpdateLevelTimings();
+			}
+
+			numClearingLines = 0;
+
+			movementPieceTickTime = 0;
+			gravityPieceCells = 0;
+		}
+		else
+			return events;
+	}
+
+	movementPieceTickTime += TICK_TIME_SCALE;
+
+	UpdatePieceRotation(input);
+	UpdatePieceMovement(input);
+
+	if (input.IsPressed(INPUT_HARD_DROP))
+	{
+		HardDropPiece();
+		PlacePiece();
+
+		if (!board.CanPieceExistAt(currentPieceMask, currentPiecePosition))
+			EndGame();
+	}
+	else if (input.IsPressed(INPUT_HOLD) && !hasSwitchedPiece)
+		HoldPiece();
+	else
+		UpdatePieceGravity(input);
+
+	return events;
+}
+
+void Simulation::LineClearCheck(int topY, int bottomY)
+{
+	//check affected lines
+	for (int y = topY; y <= bottomY; y++)
+	{
+		if (board.IsLineFull(y))
+		{
+			//start line clear animation for blocks
+			for (int x = 0; x < rules.GridSize.x; x++)
+			{
+				board.SetCellState(x, y, BLOCK_CLEARING);
+			}
+
+			clearingLines[numClearingLines++] = y;
+			isClearingLines = true;
+		}
+	}
+
+	if (isClearingLines)
+		lineClearingTickTime = 0;
+}
+
+void Simulation::EndGame()
+{
+	gameOver = true;
+	SetCurrentPiece(Piece());
+
+	events |= EVENT_GAME_OVER;
+}
+
+#pragma endregion
+
+#pragma region Snapshots
+
+//Pieces of the piece set only need their type and rotation, other pieces are written block by block
+static void WritePiece(SnapshotWriter& writer, const Piece& piece)
+{
+	writer.WriteInt(piece.type);
+
+	if (piece.type >= 0)
+	{
+		writer.WriteInt(piece.rotation);
+		return;
+	}
+
+	writer.WriteInt(piece.numBlocks);
+	writer.WriteByte(piece.colorIndex);
+	writer.WriteFloat(piece.pivotOffset.x);
+	writer.WriteFloat(piece.pivotOffset.y);
+
+	for (int i = 0; i < piece.numBlocks; i++)
+	{
+		writer.WriteInt(piece.blockOffsets[i].x);
+		writer.WriteInt(piece.blockOffsets[i].y);
+	}
+}
+
+static Piece ReadPiece(SnapshotReader& reader, const PieceSet& pieceSet)
+{
+	int type = reader.ReadInt(-1, pieceSet.GetNumPieces() - 1);
+
+	if (type >= 0)
+	{
+		int rotation = reader.ReadInt(0, NUM_PIECE_ROTATIONS - 1);
+
+		if (!reader.IsValid())
+			return Piece();
+
+		const PieceShape& shape = pieceSet.GetShape(type, rotation);
+		Piece piece = pieceSet.GetPiece(type);
+
+		for (int i = 0; i < shape.numBlocks; i++)
+			piece.blockOffsets[i] = shape.blockOffsets[i];
+
+		piece.rotation = rotation;
+
+		return piece;
+	}
+
+	Piece piece = Piece(reader.ReadInt(0, MAX_PIECE_BLOCKS));
+	piece.colorIndex = reader.ReadByte();
+	piece.pivotOffset.x = reader.ReadFloat();
+	piece.pivotOffset.y = reader.ReadFloat();
+
+	if (!reader.IsValid())
+		return Piece();
+
+	for (int i = 0; i < piece.numBlocks; i++)
+	{
+		piece.blockOffsets[i].x = reader.ReadInt(-PIECE_MASK_MAX_COLUMNS, PIECE_MASK_MAX_COLUMNS);
+		piece.blockOffsets[i].y = reader.ReadInt(-PIECE_MASK_MAX_ROWS, PIECE_MASK_MAX_ROWS);
+	}
+
+	return reader.IsValid() ? piece : Piece();
+}
+
+void Simulation::SaveSnapshot(std::vector<uint8_t>& data) const
+{
+	SnapshotWriter writer = SnapshotWriter(data);
+
+	writer.WriteByte('K');
+	writer.WriteByte('S');
+	writer.WriteInt(SNAPSHOT_VERSION);
+
+	WriteSnapshotState(writer);
+	board.WriteSnapshot(writer);
+}
+
+uint64_t Simulation::GetStateHash() const
+{
+	std::vector<uint8_t> data;
+	SaveSnapshot(data);
+
+	return HashSnapshot(data.data(), data.size());
+}
+
+uint64_t Simulation::GetZobristHash() const
+{
+	uint64_t hash = board.GetHash();
+
+	uint64_t currentPieceValue = ((uint64_t)(uint32_t)currentPiece.type << 32) | (uint32_t)currentPiece.rotation;
+	uint64_t positionValue = ((uint64_t)(uint32_t)currentPiecePosition.x << 32) | (uint32_t)currentPiecePosition.y;
+	hash ^= GetZobristKey(ZOBRIST_CURRENT_PIECE, currentPieceValue ^ MixZobristBits(positionValue));
+
+	uint64_t holdingPieceValue = ((uint64_t)(uint32_t)holdingPiece.type << 32) | ((uint32_t)holdingPiece.rotation << 1) | (hasSwitchedPiece ? 1 : 0);
+	hash ^= GetZobristKey(ZOBRIST_HOLDING_PIECE, holdingPieceValue);
+
+	for (int i = 0; i < rules.NumUpAndComingPieces; i++)
+		hash ^= GetZobristKey(ZOBRIST_UP_AND_COMING_PIECE, ((uint64_t)i << 32) | (uint32_t)GetUpAndComingPieceType(i));
+
+	return hash;
+}
+
+bool Simulation::LoadSnapshot(const uint8_t* data, size_t size)
+{
+	SnapshotReader reader = SnapshotReader(data, size);
+
+	if (reader.ReadByte() != 'K' || reader.ReadByte() != 'S' || reader.ReadInt(0, INT32_MAX) != SNAPSHOT_VERSION)
+		return false;
+
+	bool isLoaded = ReadSnapshotState(reader) && board.ReadSnapshot(reader) && reader.IsAtEnd();
+
+	//a loaded game starts a new history
+	ClearHistory();
+
+	return isLoaded;
+}
+
+//Everything but the board
+void Simulation::WriteSnapshotState(SnapshotWriter& writer) const
+{
+	rules.WriteSnapshot(writer);
+
+	//random
+	writer.WriteUnsigned(seed);
+	random.WriteSnapshot(writer);
+	randomizer->WriteSnapshot(writer);
+
+	//pieces, the up and coming pieces are written from the next piece onwards
+	for (int i = 0; i < (int)upAndComingPieceTypes.size(); i++)
+		writer.WriteByte((uint8_t)GetUpAndComingPieceType(i));
+
+	WritePiece(writer, currentPiece);
+	writer.WriteInt(currentPiecePosition.x);
+	writer.WriteInt(currentPiecePosition.y);
+
+	WritePiece(writer, holdingPiece);
+	writer.WriteBool(hasSwitchedPiece);
+
+	//timers
+	writer.WriteSigned(gravityPieceCells);
+	writer.WriteSigned(movementPieceTickTime);
+	writer.WriteSigned(lineClearingTickTime);
+
+	//line clears
+	writer.WriteBool(isClearingLines);
+	writer.WriteInt(numClearingLines);
+
+	for (int i = 0; i < numClearingLines; i++)
+		writer.WriteInt(clearingLines[i]);
+
+	writer.WriteBool(gameOver);
+
+	//statistics
+	writer.WriteInt(score);
+	writer.WriteInt(level);
+	writer.WriteInt(totalLinesCleared);
+	writer.WriteSigned(ticksPlayed);
+}
+
+bool Simulation::ReadSnapshotState(SnapshotReader& reader)
+{
+	//rules
+	GameRules snapshotRules = GameRules();
+
+	if (!snapshotRules.ReadSnapshot(reader))
+		return false;
+
+	//changing the rules allocates, restoring a game with the same rules doesn't
+	if (!snapshotRules.IsSameAs(rules))
+		SetRules(snapshotRules);
+
+	//random
+	seed = reader.ReadUnsigned();
+	random.ReadSnapshot(reader);
+	randomizer->ReadSnapshot(reader);
+
+	//pieces
+	upAndComingPiecesStart = 0;
+
+	for (int i = 0; i < (int)upAndComingPieceTypes.size(); i++)
+	{
+		uint8_t pieceType = reader.ReadByte();
+
+		if (pieceType >= rules.Pieces->GetNumPieces())
+			reader.Fail();
+
+		upAndComingPieceTypes[i] = pieceType;
+	}
+
+	SetCurrentPiece(ReadPiece(reader, *rules.Pieces));
+	currentPiecePosition.x = reader.ReadInt(INT32_MIN, INT32_MAX);
+	currentPiecePosition.y = reader.ReadInt(INT32_MIN, INT32_MAX);
+
+	holdingPiece = ReadPiece(reader, *rules.Pieces);
+	hasSwitchedPiece = reader.ReadBool();
+
+	//timers
+	gravityPieceCells = reader.ReadSigned();
+	movementPieceTickTime = reader.ReadSigned();
+	lineClearingTickTime = reader.ReadSigned();
+
+	//line clears
+	isClearingLines = reader.ReadBool();
+	numClearingLines = reader.ReadInt(0, PIECE_MASK_MAX_ROWS);
+
+	for (int i = 0; i < numClearingLines; i++)
+		clearingLines[i] = reader.ReadInt(0, rules.GridSize.y - 1);
+
+	gameOver = reader.ReadBool();
+
+	//statistics
+	score = reader.ReadInt(INT32_MIN, INT32_MAX);
+	level = reader.ReadInt(1, INT32_MAX);
+	totalLinesCleared = reader.ReadInt(0, INT32_MAX);
+	ticksPlayed = reader.ReadSigned();
+
+	UpdateLevelTimings();
+
+	events = EVENT_NONE;
+
+	return reader.IsValid();
+}
+
+#pragma endregion
+
+#pragma region History
+
+//Remembers the game right before it changes, the entry shares its lines with the previous entries
+void Simulation::RecordHistory()
+{
+	//going on after going back forgets the entries that came after
+	history.resize(historyIndex);
+
+	HistoryEntry& entry = history.emplace_back();
+
+	SnapshotWriter writer = SnapshotWriter(entry.state);
+	WriteSnapshotState(writer);
+
+	entry.topLine = historyTopLine;
+
+	historyIndex = (int)history.size();
+}
+
+void Simulation::ClearHistory()
+{
+	history.clear();
+	historyIndex = 0;
+
+	historyTopLine = nullptr;
+
+	if (recordHistory)
+		UpdateHistoryLines(rules.GridSize.y - 1);
+}
+
+//Replaces the lines from bottomY up with new ones read from the board, the lines below it stay shared
+void Simulation::UpdateHistoryLines(int bottomY)
+{
+	int bottomLineIndex = std::max(rules.GridSize.y - 1 - bottomY, 0);
+
+	std::shared_ptr<HistoryLine> line = historyTopLine;
+
+	while (line != nullptr && line->lineIndex >= bottomLineIndex)
+		line = line->below;
+
+	int topY = rules.GridSize.y;
+
+	for (int x = 0; x < rules.GridSize.x; x++)
+		topY = std::min(topY, board.GetColumnTop(x));
+
+	for (int lineIndex = bottomLineIndex; lineIndex <= rules.GridSize.y - 1 - topY; lineIndex++)
+	{
+		int y = rules.GridSize.y - 1 - lineIndex;
+
+		line = std::make_shared<HistoryLine>(std::move(line), lineIndex);
+
+		for (int x = 0; x < rules.GridSize.x; x++)
+			line->cells[x] = board.GetCell(x, y);
+	}
+
+	historyTopLine = std::move(line);
+}
+
+void Simulation::SetRecordHistory(bool recordHistory)
+{
+	if (this->recordHistory == recordHistory)
+		return;
+
+	this->recordHistory = recordHistory;
+
+	ClearHistory();
+}
+
+bool Simulation::IsRecordingHistory() const
+{
+	return recordHistory;
+}
+
+int Simulation::GetHistorySize() const
+{
+	return (int)history.size();
+}
+
+int Simulation::GetHistoryIndex() const
+{
+	return historyIndex;
+}
+
+bool Simulation::Undo()
+{
+	return historyIndex > 0 && SeekHistory(historyIndex - 1);
+}
+
+bool Simulation::Redo()
+{
+	return historyIndex + 1 < (int)history.size() && SeekHistory(historyIndex + 1);
+}
+
+//Only the lines that the current board and the entry don't share are written, going back or forward one entry only touches the lines the placement changed
+bool Simulation::SeekHistory(int index)
+{
+	if (!recordHistory || index < 0 || index > (int)history.size())
+		return false;
+
+	//the game as it is now becomes the last entry, so it can be gone forward to again
+	if (historyIndex == (int)history.size())
+	{
+		if (index == historyIndex)
+			return true;
+
+		RecordHistory();
+		historyIndex--;
+	}
+	else if (index == (int)history.size())
+		return false;
+
+	const HistoryEntry& entry = history[index];
+
+	SnapshotReader reader = SnapshotReader(entry.state.data(), entry.state.size());
+	ReadSnapshotState(reader);
+
+	//both lists go down until they reach the lines they share
+	const HistoryLine* line = entry.topLine.get();
+	const HistoryLine* currentLine = historyTopLine.get();
+
+	while (line != currentLine)
+	{
+		if (line == nullptr || (currentLine != nullptr && currentLine->lineIndex > line->lineIndex))
+		{
+			//lines above the top of the entry are empty
+			for (int x = 0; x < rules.GridSize.x; x++)
+				board.SetCell(x, rules.GridSize.y - 1 - currentLine->lineIndex, BlockCell(BLOCK_EMPTY, PALETTE_BLANK));
+
+			currentLine = currentLine->below.get();
+		}
+		else
+		{
+			for (int x = 0; x < rules.GridSize.x; x++)
+				board.SetCell(x, rules.GridSize.y - 1 - line->lineIndex, line->cells[x]);
+
+			if (currentLine != nullptr && currentLine->lineIndex == line->lineIndex)
+				currentLine = currentLine->below.get();
+
+			line = line->below.get();
+		}
+	}
+
+	historyTopLine = entry.topLine;
+	historyIndex = index;
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region Pieces
+
+void Simulation::SetCurrentPiece(const Piece& piece)
+{
+	currentPiece = piece;
+
+	if (piece.type >= 0)
+		currentPieceMask = rules.Pieces->GetShape(piece.type, piece.rotation).mask;
+	else
+		currentPieceMask = PieceMask::FromPiece(piece);
+}
+
+void Simulation::SetCurrentPieceRotation(int rotation)
+{
+	const PieceShape& shape = rules.Pieces->GetShape(currentPiece.type, rotation);
+
+	//blocks are overwritten in place, the amount of blocks doesn't change between rotations
+	for (int i = 0; i < shape.numBlocks; i++)
+		currentPiece.blockOffsets[i] = shape.blockOffsets[i];
+
+	currentPiece.rotation = rotation;
+	currentPieceMask = shape.mask;
+}
+
+void Simulation::NextPiece()
+{
+	if (upAndComingPieceTypes.empty())
+	{
+		SetCurrentPiece(rules.Pieces->GetPiece(randomizer->Next(random)));
+	}
+	else
+	{
+		//get next piece in line, its spot in the ring is filled with a new random piece and becomes the last in line
+		SetCurrentPiece(rules.Pieces->GetPiece(upAndComingPieceTypes[upAndComingPiecesStart]));
+
+		upAndComingPieceTypes[upAndComingPiecesStart] = randomizer->Next(random);
+		upAndComingPiecesStart = (upAndComingPiecesStart + 1) % (int)upAndComingPieceTypes.size();
+	}
+
+	currentPiecePosition = GetSpawnPosition();
+
+	gravityPieceCells = 0;
+}
+
+void Simulation::PlacePiece()
+{
+	if (recordHistory)
+		RecordHistory();
+
+	int topPieceY = INT32_MAX;
+	int bottomPieceY = INT32_MIN;
+
+	//Place piece into grid
+	for (int i = 0; i < currentPiece.numBlocks; i++)
+	{
+		if (!board.IsCellInBounds(currentPiecePosition.x + currentPiece.blockOffsets[i].x, currentPiecePosition.y + currentPiece.blockOffsets[i].y))
+			continue;
+
+		if (currentPiece.blockOffsets[i].y > bottomPieceY)
+			bottomPieceY = currentPiece.blockOffsets[i].y;
+
+		if (currentPiece.blockOffsets[i].y < topPieceY)
+			topPieceY = currentPiece.blockOffsets[i].y;
+
+		board.SetCell(currentPiecePosition.x + currentPiece.blockOffsets[i].x, currentPiecePosition.y + currentPiece.blockOffsets[i].y, BlockCell(BLOCK_GRID, currentPiece.colorIndex));
+	}
+
+	hasSwitchedPiece = false;
+	events |= EVENT_PIECE_PLACED;
+
+	lastPlacement.piece = currentPiece;
+	lastPlacement.position = currentPiecePosition;
+	lastPlacement.linesCleared = 0;
+
+	//Checks for cleared lines, unless the whole piece is above the grid, which kicks can leave it at
+	if (topPieceY <= bottomPieceY)
+	{
+		LineClearCheck(currentPiecePosition.y + topPieceY, currentPiecePosition.y + bottomPieceY);
+		lastPlacement.linesCleared = numClearingLines;
+
+		if (recordHistory)
+			UpdateHistoryLines(currentPiecePosition.y + bottomPieceY);
+	}
+
+	NextPiece();
+}
+
+void Simulation::HoldPiece()
+{
+	if (recordHistory)
+		RecordHistory();
+
+	Piece tempPiece = holdingPiece;
+
+	holdingPiece = currentPiece;
+
+	//Go to next piece if we weren't holding a piece yet
+	if (tempPiece.numBlocks == 0)
+		NextPiece();
+	//Swap held piece out into current piece
+	else
+		SetCurrentPiece(tempPiece);
+
+	currentPiecePosition = GetSpawnPosition();
+	gravityPieceCells = 0;
+	hasSwitchedPiece = true;
+
+	events |= EVENT_PIECE_HELD;
+}
+
+void Simulation::HardDropPiece()
+{
+	//Instantly move piece downwards until it can't anymore
+	Vector2Int dropPosition = GetDropPosition();
+
+	//two points for each cell dropped
+	score += (dropPosition.y - currentPiecePosition.y) * 2;
+
+	currentPiecePosition = dropPosition;
+}
+
+void Simulation::UpdatePieceRotation(const SimulationInput& input)
+{
+	int rotation = currentPiece.rotation;
+
+	//rotation
+	if (input.IsPressed(INPUT_ROTATE_COUNTER_CLOCKWISE))
+		rotation += 3; //Counter-clockwise
+	else if (input.IsPressed(INPUT_ROTATE_CLOCKWISE))
+		rotation += 1; //Clockwise
+	else if (input.IsPressed(INPUT_ROTATE_HALF_CIRCLE))
+		rotation += 2;
+	else
+		return;
+
+	if (currentPiece.type < 0)
+		return;
+
+	rotation %= NUM_PIECE_ROTATIONS;
+
+	if (KickPieceRotation(board, rules.RotationSystem, *rules.Pieces, currentPiece.type, currentPiece.rotation, rotation, currentPiecePosition))
+		SetCurrentPieceRotation(rotation);
+}
+
+void Simulation::UpdatePieceMovement(const SimulationInput& input)
+{
+	//movement
+	Vector2Int movement = { 0, 0 };
+
+	if (input.IsDown(INPUT_MOVE_RIGHT))
+	{
+		movement.x = 1;
+
+		if (input.IsPressed(INPUT_MOVE_RIGHT))
+		{
+			if (board.CanPieceExistAt(currentPieceMask, Vector2Int{ currentPiecePosition.x + 1, currentPiecePosition.y }))
+				currentPiecePosition = Vector2Int{ currentPiecePosition.x + 1, currentPiecePosition.y };
+
+			movementPieceTickTime = -movePieceTickTime; //extra delay before repeated movements
+		}
+	}
+	else if (input.IsDown(INPUT_MOVE_LEFT))
+	{
+		movement.x = -1;
+
+		if (input.IsPressed(INPUT_MOVE_LEFT))
+		{
+			if (board.CanPieceExistAt(currentPieceMask, Vector2Int{ currentPiecePosition.x - 1, currentPiecePosition.y }))
+				currentPiecePosition = Vector2Int{ currentPiecePosition.x - 1, currentPiecePosition.y };
+
+			movementPieceTickTime = -movePieceTickTime; //extra delay before repeated movements
+		}
+	}
+
+	if ((input.IsDown(INPUT_MOVE_LEFT) || input.IsDown(INPUT_MOVE_RIGHT)) && movementPieceTickTime >= movePieceTickTime)
+	{
+		while (movementPieceTickTime >= movePieceTickTime)
+		{
+			movementPieceTickTime -= movePieceTickTime;
+
+			Vector2Int newPiecePosition = { currentPiecePosition.x + movement.x, currentPiecePosition.y + movement.y };
+
+			if (board.CanPieceExistAt(currentPieceMask, newPiecePosition))
+				currentPiecePosition = newPiecePosition;
+			else
+				break;
+		}
+	}
+}
+
+void Simulation::UpdatePieceGravity(const SimulationInput& input)
+{
+	int64_t cellsPerTick = gravityCellsPerTick;
+
+	//Soft drop speed
+	if (input.IsDown(INPUT_SOFT_DROP) && cellsPerTick < softDropCellsPerTick)
+		cellsPerTick = softDropCellsPerTick;
+
+	gravityPieceCells += cellsPerTick;
+
+	//pressing soft drop moves the piece down right away
+	if (input.IsPressed(INPUT_SOFT_DROP))
+		gravityPieceCells = std::max(gravityPieceCells, GRAVITY_CELL_SCALE);
+
+	int64_t numCells = gravityPieceCells / GRAVITY_CELL_SCALE;
+
+	if (numCells > 0)
+	{
+		gravityPieceCells -= numCells * GRAVITY_CELL_SCALE;
+
+		//however many cells the piece falls this tick, it only takes a single drop distance query
+		int dropDistance = board.GetDropDistance(currentPieceMask, currentPiecePosition);
+		int numDroppedCells = (int)std::min(numCells, (int64_t)dropDistance);
+
+		currentPiecePosition = { currentPiecePosition.x, currentPiecePosition.y + numDroppedCells };
+
+		//plus one point for each cell dropped with soft drop
+		if (input.IsDown(INPUT_SOFT_DROP))
+			score += numDroppedCells;
+
+		//the piece landed with cells left to fall
+		if (numCells > dropDistance)
+			PlacePiece();
+	}
+
+	if (!board.CanPieceExistAt(currentPieceMask, currentPiecePosition))
+		EndGame();
+}
+
+#pragma endregion
+
+#pragma region Accessors
+
+uint64_t Simulation::GetSeed() const
+{
+	return seed;
+}
+
+const Board& Simulation::GetBoard() const
+{
+	return board;
+}
+
+const Piece& Simulation::GetCurrentPiece() const
+{
+	return currentPiece;
+}
+
+Vector2Int Simulation::GetCurrentPiecePosition() const
+{
+	return currentPiecePosition;
+}
+
+Vector2Int Simulation::GetDropPosition() const
+{
+	Vector2Int dropPosition = currentPiecePosition;
+
+	if (currentPiece.numBlocks == 0)
+		return dropPosition;
+
+	dropPosition.y += board.GetDropDistance(currentPieceMask, currentPiecePosition);
+
+	return dropPosition;
+}
+
+Vector2Int Simulation::GetSpawnPosition() const
+{
+	return Vector2Int{ rules.GridSize.x / 2, 0 };
+}
+
+const PiecePlacement& Simulation::GetLastPlacement() const
+{
+	return lastPlacement;
+}
+
+const Piece& Simulation::GetHoldingPiece() const
+{
+	return holdingPiece;
+}
+
+bool Simulation::HasSwitchedPiece() const
+{
+	return hasSwitchedPiece;
+}
+
+int Simulation::GetUpAndComingPieceType(int index) const
+{
+	return upAndComingPieceTypes[(upAndComingPiecesStart + index) % upAndComingPieceTypes.size()];
+}
+
+bool Simulation::IsClearingLines() const
+{
+	return isClearingLines;
+}
+
+float Simulation::GetLineClearTimeSeconds() const
+{
+	return (float)((double)lineClearTickTime / ((double)TICK_TIME_SCALE * rules.TickRate));
+}
+
+float Simulation::GetLineClearingTime() const
+{
+	return (float)((double)lineClearingTickTime / ((double)TICK_TIME_SCALE * rules.TickRate));
+}
+
+bool Simulation::IsGameOver() const
+{
+	return gameOver;
+}
+
+bool Simulation::IsGravityInstant() const
+{
+	return gravityCellsPerTick >= (int64_t)rules.GridSize.y * GRAVITY_CELL_SCALE;
+}
+
+int Simulation::GetScore() const
+{
+	return score;
+}
+
+int Simulation::GetLevel() const
+{
+	return level;
+}
+
+void Simulation::SetLevel(int level)
+{
+	this->level = level;
+
+	UpdateLevelTimings();
+}
+
+int Simulation::GetTotalLinesCleared() const
+{
+	return totalLinesCleared;
+}
+
+int64_t Simulation::GetTicksPlayed() const
+{
+	return ticksPlayed;
+}
+
+//Derived from the tick count, so it doesn't drift over long games
+float Simulation::GetTimePlayingSeconds() const
+{
+	return (float)((double)ticksPlayed / rules.TickRate);
+}
+
+#pragma endregion
\ No newline at end of file
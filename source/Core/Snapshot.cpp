@@ -0,0 +1,198 @@
+#include <cstring>
+
+#include "Core/Snapshot.h"
+
+#pragma region Writer
+
+void SnapshotWriter::WriteByte(uint8_t value)
+{
+	data.push_back(value);
+}
+
+void SnapshotWriter::WriteBool(bool value)
+{
+	data.push_back(value ? 1 : 0);
+}
+
+//7 bits per byte, the high bit is set on every byte except for the last one
+void SnapshotWriter::WriteUnsigned(uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		data.push_back((uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+
+	data.push_back((uint8_t)value);
+}
+
+//zigzag encoded, so small negative values stay small as well
+void SnapshotWriter::WriteSigned(int64_t value)
+{
+	WriteUnsigned(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+void SnapshotWriter::WriteInt(int value)
+{
+	WriteSigned(value);
+}
+
+//little endian, for values that use all of their bits such as random states
+void SnapshotWriter::WriteUInt32(uint32_t value)
+{
+	for (int i = 0; i < 4; i++)
+		data.push_back((uint8_t)(value >> (8 * i)));
+}
+
+void SnapshotWriter::WriteFloat(float value)
+{
+	uint32_t bits = 0;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	WriteUInt32(bits);
+}
+
+//length first, then the characters
+void SnapshotWriter::WriteString(const std::string& value)
+{
+	WriteUnsigned(value.size());
+	data.insert(data.end(), value.begin(), value.end());
+}
+
+#pragma endregion
+
+#pragma region Reader
+
+uint8_t SnapshotReader::ReadByte()
+{
+	if (failed || position >= size)
+	{
+		failed = true;
+		return 0;
+	}
+
+	return data[position++];
+}
+
+bool SnapshotReader::ReadBool()
+{
+	uint8_t value = ReadByte();
+
+	if (value > 1)
+		Fail();
+
+	return value == 1;
+}
+
+uint64_t SnapshotReader::ReadUnsigned()
+{
+	uint64_t value = 0;
+
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		uint8_t byte = ReadByte();
+		value |= (uint64_t)(byte & 0x7F) << shift;
+
+		if ((byte & 0x80) == 0)
+			return failed ? 0 : value;
+	}
+
+	//too many bytes for a 64 bit value
+	Fail();
+	return 0;
+}
+
+int64_t SnapshotReader::ReadSigned()
+{
+	uint64_t value = ReadUnsigned();
+
+	return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+uint32_t SnapshotReader::ReadUInt32()
+{
+	uint32_t value = 0;
+
+	for (int i = 0; i < 4; i++)
+		value |= (uint32_t)ReadByte() << (8 * i);
+
+	return failed ? 0 : value;
+}
+
+float SnapshotReader::ReadFloat()
+{
+	uint32_t bits = ReadUInt32();
+
+	float value = 0.0f;
+	std::memcpy(&value, &bits, sizeof(value));
+
+	return value;
+}
+
+std::string SnapshotReader::ReadString(size_t maxLength)
+{
+	uint64_t length = ReadUnsigned();
+
+	if (failed || length > maxLength || length > size - position)
+	{
+		failed = true;
+		return std::string();
+	}
+
+	std::string value = std::string((const char*)data + position, (size_t)length);
+	position += (size_t)length;
+
+	return value;
+}
+
+int SnapshotReader::ReadInt(int min, int max)
+{
+	int64_t value = ReadSigned();
+
+	if (value < min || value > max)
+	{
+		Fail();
+		return 0;
+	}
+
+	return (int)value;
+}
+
+void SnapshotReader::Fail()
+{
+	failed = true;
+}
+
+bool SnapshotReader::IsValid() const
+{
+	return !failed;
+}
+
+bool SnapshotReader::IsAtEnd() const
+{
+	return position == size;
+}
+
+size_t SnapshotReader::GetPosition() const
+{
+	return position;
+}
+
+#pragma endregion
+
+#pragma region Hash
+
+uint64_t HashSnapshot(const uint8_t* data, size_t size)
+{
+	uint64_t hash = 0xcbf29ce484222325;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= data[i];
+		hash *= 0x100000001b3;
+	}
+
+	return hash;
+}
+
+#pragma endregion
\ No newline at end of file
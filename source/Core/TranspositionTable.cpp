@@ -0,0 +1,189 @@
+#include <bit>
+#include <cstring>
+
+#include "Core/TranspositionTable.h"
+
+//Layout of the data word: score bits, then depth and search. The used bit keeps the data of a stored entry from being 0.
+const int TRANSPOSITION_DEPTH_SHIFT = 32;
+const int TRANSPOSITION_SEARCH_SHIFT = 40;
+const uint64_t TRANSPOSITION_USED_BIT = (uint64_t)1 << 63;
+
+TranspositionTable::TranspositionTable(size_t sizeBytes)
+{
+	size_t maxBuckets = sizeBytes / sizeof(TranspositionBucket);
+	numBuckets = (maxBuckets > 1) ? std::bit_floor(maxBuckets) : 1;
+
+	buckets = std::make_unique<TranspositionBucket[]>(numBuckets);
+
+	Clear();
+}
+
+void TranspositionTable::Clear()
+{
+	for (size_t i = 0; i < numBuckets; i++)
+	{
+		for (TranspositionSlot& slot : buckets[i].slots)
+		{
+			slot.check.store(0, std::memory_order_relaxed);
+			slot.data.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	search.store(0, std::memory_order_relaxed);
+
+	ResetCounters();
+}
+
+void TranspositionTable::StartSearch()
+{
+	search.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t TranspositionTable::PackData(const TranspositionEntry& entry, uint8_t entrySearch)
+{
+	uint32_t scoreBits;
+	std::memcpy(&scoreBits, &entry.score, sizeof(scoreBits));
+
+	uint64_t data = scoreBits | TRANSPOSITION_USED_BIT;
+	data |= (uint64_t)(uint8_t)entry.depth << TRANSPOSITION_DEPTH_SHIFT;
+	data |= (uint64_t)entrySearch << TRANSPOSITION_SEARCH_SHIFT;
+
+	return data;
+}
+
+bool TranspositionTable::Probe(uint64_t key, TranspositionEntry& entry)
+{
+	TranspositionCounters& shard = counters[key >> 60];
+	shard.numProbes.fetch_add(1, std::memory_order_relaxed);
+
+	TranspositionSlot* bucket = buckets[key & (numBuckets - 1)].slots;
+
+	for (int i = 0; i < TRANSPOSITION_BUCKET_SIZE; i++)
+	{
+		uint64_t data = bucket[i].data.load(std::memory_order_relaxed);
+		uint64_t check = bucket[i].check.load(std::memory_order_relaxed);
+
+		if (data == 0 || (check ^ data) != key)
+			continue;
+
+		uint32_t scoreBits = (uint32_t)data;
+		std::memcpy(&entry.score, &scoreBits, sizeof(scoreBits));
+		entry.depth = (int)(uint8_t)(data >> TRANSPOSITION_DEPTH_SHIFT);
+
+		shard.numHits.fetch_add(1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	return false;
+}
+
+void TranspositionTable::Store(uint64_t key, const TranspositionEntry& entry)
+{
+	TranspositionSlot* bucket = buckets[key & (numBuckets - 1)].slots;
+
+	uint8_t currentSearch = search.load(std::memory_order_relaxed);
+
+	//the same position or an empty entry, otherwise the oldest and then shallowest entry
+	int replaced = 0;
+	int replacedAge = -1;
+	int replacedDepth = 0;
+	bool isReplacing = true;
+
+	for (int i = 0; i < TRANSPOSITION_BUCKET_SIZE; i++)
+	{
+		uint64_t data = bucket[i].data.load(std::memory_order_relaxed);
+		uint64_t check = bucket[i].check.load(std::memory_order_relaxed);
+
+		if (data == 0 || (check ^ data) == key)
+		{
+			replaced = i;
+			isReplacing = false;
+			break;
+		}
+
+		int age = (uint8_t)(currentSearch - (uint8_t)(data >> TRANSPOSITION_SEARCH_SHIFT));
+		int depth = (int)(uint8_t)(data >> TRANSPOSITION_DEPTH_SHIFT);
+
+		if (age > replacedAge || (age == replacedAge && depth < replacedDepth))
+		{
+			replaced = i;
+			replacedAge = age;
+			replacedDepth = depth;
+		}
+	}
+
+	uint64_t data = PackData(entry, currentSearch);
+
+	//another thread can write the same entry meanwhile, whichever pair of words ends up there either matches a key or doesn't
+	bucket[replaced].data.store(data, std::memory_order_relaxed);
+	bucket[replaced].check.store(key ^ data, std::memory_order_relaxed);
+
+	TranspositionCounters& shard = counters[key >> 60];
+	shard.numStores.fetch_add(1, std::memory_order_relaxed);
+
+	if (isReplacing)
+		shard.numReplacements.fetch_add(1, std::memory_order_relaxed);
+}
+
+#pragma region Accessors
+
+size_t TranspositionTable::GetNumEntries() const
+{
+	return numBuckets * TRANSPOSITION_BUCKET_SIZE;
+}
+
+size_t TranspositionTable::GetSizeBytes() const
+{
+	return numBuckets * sizeof(TranspositionBucket);
+}
+
+uint64_t TranspositionTable::SumCounters(std::atomic<uint64_t> TranspositionCounters::* counter) const
+{
+	uint64_t sum = 0;
+
+	for (const TranspositionCounters& shard : counters)
+		sum += (shard.*counter).load(std::memory_order_relaxed);
+
+	return sum;
+}
+
+uint64_t TranspositionTable::GetNumProbes() const
+{
+	return SumCounters(&TranspositionCounters::numProbes);
+}
+
+uint64_t TranspositionTable::GetNumHits() const
+{
+	return SumCounters(&TranspositionCounters::numHits);
+}
+
+uint64_t TranspositionTable::GetNumStores() const
+{
+	return SumCounters(&TranspositionCounters::numStores);
+}
+
+uint64_t TranspositionTable::GetNumReplacements() const
+{
+	return SumCounters(&TranspositionCounters::numReplacements);
+}
+
+double TranspositionTable::GetHitRate() const
+{
+	uint64_t numProbes = GetNumProbes();
+
+	return (numProbes > 0) ? (double)GetNumHits() / (double)numProbes : 0.0;
+}
+
+void TranspositionTable::ResetCounters()
+{
+	for (TranspositionCounters& shard : counters)
+	{
+		shard.numProbes.store(0, std::memory_order_relaxed);
+		shard.numHits.store(0, std::memory_order_relaxed);
+		shard.numStores.store(0, std::memory_order_relaxed);
+		shard.numReplacements.store(0, std::memory_order_relaxed);
+	}
+}
+
+#pragma endregion
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include <cstdint>
+#include <random>
+#include <filesystem>
 
 #include "Kiatris.h"
 #include "Game/SceneGame.h"
@@ -9,6 +11,17 @@ const float BASE_FONT_SIZE = 12.0f;
 //Base font spacing multiplier
 const float BASE_FONT_SPACING = 0.1f;
 
+//Finished games are saved here, named after their seed
+const char* REPLAY_DIRECTORY = "replays";
+
+//Title menu idle time before the bot starts playing on its own
+const float ATTRACT_MODE_IDLE_SECONDS = 30.0f;
+
+//Options in the options menu, the back button comes after them
+const int NUM_OPTIONS = 9;
+//Options that fit on screen above the back button
+const int NUM_VISIBLE_OPTIONS = 5;
+
 /// Returns a text size that fits the given text within the specified width using the specified font and spacing (1.0 = letter height)
 static float FitTextWidth(raylib::Font& font, const std::string text, const float width, const float percentageSpacing)
 {
@@ -20,11 +33,76 @@ static bool IsConfirmButtonPressed()
 	return IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE);
 }
 
+static raylib::Color ToRaylibColor(BlockColor color)
+{
+	return raylib::Color(color.r, color.g, color.b, color.a);
+}
+
+/// Maps the keyboard state to the simulation's input actions
+static SimulationInput ReadKeyboardInput()
+{
+	SimulationInput input = SimulationInput();
+
+	if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A))
+		input.down |= INPUT_MOVE_LEFT;
+
+	if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D))
+		input.down |= INPUT_MOVE_RIGHT;
+
+	if (IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S))
+		input.down |= INPUT_SOFT_DROP;
+
+	if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A))
+		input.pressed |= INPUT_MOVE_LEFT;
+
+	if (IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D))
+		input.pressed |= INPUT_MOVE_RIGHT;
+
+	if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S))
+		input.pressed |= INPUT_SOFT_DROP;
+
+	if (IsConfirmButtonPressed())
+		input.pressed |= INPUT_HARD_DROP;
+
+	if (IsKeyPressed(KEY_LEFT_CONTROL) || IsKeyPressed(KEY_RIGHT_CONTROL) || IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_E))
+		input.pressed |= INPUT_ROTATE_COUNTER_CLOCKWISE;
+
+	if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_X) || IsKeyPressed(KEY_R) || IsKeyPressed(KEY_W))
+		input.pressed |= INPUT_ROTATE_CLOCKWISE;
+
+	if (IsKeyPressed(KEY_T))
+		input.pressed |= INPUT_ROTATE_HALF_CIRCLE;
+
+	if (IsKeyPressed(KEY_C) || IsKeyPressed(KEY_LEFT_SHIFT) || IsKeyPressed(KEY_RIGHT_SHIFT))
+		input.pressed |= INPUT_HOLD;
+
+	return input;
+}
+
 void SceneGame::Init()
 {
 	
 }
 
+bool SceneGame::WatchReplay(const std::string& path)
+{
+	std::string error;
+
+	if (!watchedReplay.LoadFromFile(path, error))
+	{
+		std::cout << "Failed to load replay: " << error << std::endl;
+		return false;
+	}
+
+	std::cout << "Watching replay: " << path << std::endl;
+
+	isWatchingReplay = true;
+	menuState = MENU_NONE;
+	StartGame();
+
+	return true;
+}
+
 void SceneGame::Update()
 {
 	//Menu theme
@@ -54,6 +132,13 @@ void SceneGame::Update()
 			break;
 		default:
 
+			//any key stops attract mode
+			if (isAttractMode && GetKeyPressed() != 0)
+			{
+				ReturnToMenu();
+				return;
+			}
+
 			if (gameOver)
 			{
 				UpdateGameOver();
@@ -75,7 +160,7 @@ void SceneGame::Update()
 
 #if DEBUG
 			if (IsKeyPressed(KEY_B))
-				level++;
+				simulation.SetLevel(simulation.GetLevel() + 1);
 #endif
 
 			if (!gamePaused)
@@ -95,42 +180,28 @@ void SceneGame::Update()
 
 void SceneGame::StartGame()
 {
-	
-	//main
 	gameOver = false;
 	gamePaused = false;
-	isClearingLines = false;
-	clearingLines.clear();
-
-	//delta times
-	gravityPieceDeltaTime = 0.0f;
-	movementPieceDeltaTime = 0.0f;
-	deltaLineClearingTime = 0.0f;
 
-	//statistics
-	timePlayingSeconds = 0.0f;
-	totalLinesCleared = 0;
-	score = 0;
-	level = 1;
+	tickAccumulatorSeconds = 0.0f;
+	pendingPressedInput = INPUT_NONE;
 
-	//pieces
-	holdingPiece = Piece(0); //no piece
+	bot.Reset();
 
-	upAndComingPieces.clear();
-	upAndComingPieces.resize(gameOptions.NumUpAndComingPieces);
-
-	for (int i = 0; i < gameOptions.NumUpAndComingPieces; i++)
-		upAndComingPieces[i] = GetRandomPieceFromBag();
+	if (isWatchingReplay)
+	{
+		replayPlayer.Start(simulation);
+		hasReportedDesync = false;
+	}
+	else
+	{
+		//every game gets a new seed, logged so the game can be played again
+		std::random_device randomDevice;
+		uint64_t seed = ((uint64_t)randomDevice() << 32) | randomDevice();
 
-	NextPiece();
+		replayRecorder.Start(simulation, gameOptions.Rules, seed);
 
-	//Clear grid
-	for (int y = 0; y < gameOptions.GridSize.y; y++)
-	{
-		for (int x = 0; x < gameOptions.GridSize.x; x++)
-		{
-			grid[y][x] = BlockCell(BLOCK_EMPTY, raylib::Color::Blank());
-		}
+		std::cout << "Seed: " << seed << std::endl;
 	}
 
 	//restart main theme
@@ -140,128 +211,101 @@ void SceneGame::StartGame()
 
 void SceneGame::UpdateGameplay()
 {
-	float deltaTime = gameWindow.GetFrameTime();
+	//frames longer than this are slowed down instead of simulating many ticks at once
+	const float MAX_FRAME_TIME = 0.25f;
+
+	//time a replay skips forward or back per key press
+	const int REPLAY_SEEK_SECONDS = 5;
 
-	timePlayingSeconds += deltaTime;
+	SimulationInput input = ReadKeyboardInput();
+	pendingPressedInput |= input.pressed;
 
-	if (isClearingLines)
+	//handing the game over to the bot and taking it back, the replay records whoever is playing
+	if (!isWatchingReplay && !isAttractMode && IsKeyPressed(KEY_F2))
 	{
-		deltaLineClearingTime += deltaTime;
+		isBotPlaying = !isBotPlaying;
+		bot.Reset();
 
-		//Wait LINE_CLEAR_TIME_SECONDS for anim and then clear line
-		if (deltaLineClearingTime >= lineClearTimeSeconds)
-		{
-			//Clear lines
-			GetSound("LineClear").Play();
-			int numClearedLines = (int)clearingLines.size();
+		std::cout << "Bot playing: " + std::to_string(isBotPlaying) << std::endl;
+	}
 
-			for (int line : clearingLines)
-				ClearLine(line);
+	//rewinding and skipping restore the closest keyframe of the replay, then simulate the ticks after it
+	if (isWatchingReplay && (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_RIGHT)))
+	{
+		int64_t seekTicks = (int64_t)REPLAY_SEEK_SECONDS * simulation.GetRules().TickRate;
+		int64_t targetTick = replayPlayer.GetTick() + (IsKeyPressed(KEY_LEFT) ? -seekTicks : seekTicks);
 
-			totalLinesCleared += numClearedLines;
+		if (!replayPlayer.Seek(simulation, targetTick))
+			std::cout << "Failed to load replay keyframe, replayed from the start" << std::endl;
 
-			std::cout << "Cleared " + std::to_string(numClearedLines) + " line(s) " << std::endl;
-			
-			switch (numClearedLines)
-			{
-				//single
-				case 1:
-					score += 100 * level;
-					break;
-				//double
-				case 2:
-					score += 300 * level;
-					break;
-				//triple
-				case 3:
-					score += 500 * level;
-					break;
-				//tetris
-				case 4:
-					score += 800 * level;
-					break;
-			}
+		tickAccumulatorSeconds = 0.0f;
+	}
 
-			isClearingLines = false;
+	//the simulation runs at a fixed tick rate, any amount of ticks can happen during a frame
+	float tickSeconds = 1.0f / (float)simulation.GetRules().TickRate;
+	tickAccumulatorSeconds += std::min(gameWindow.GetFrameTime(), MAX_FRAME_TIME);
 
-			//Level up every total 10 lines cleared
-			if (totalLinesCleared / 10 != (totalLinesCleared - numClearedLines) / 10)
-			{
-				GetSound("LevelUp").Play();
-				level++;
-			}
+	unsigned int events = EVENT_NONE;
 
-			clearingLines.clear();
+	while (tickAccumulatorSeconds >= tickSeconds && !simulation.IsGameOver())
+	{
+		tickAccumulatorSeconds -= tickSeconds;
 
-			movementPieceDeltaTime = 0.0f;
-			gravityPieceDeltaTime = 0.0f;
-		}
+		//presses only happen on the first tick that sees them
+		if (isWatchingReplay)
+			events |= replayPlayer.Step(simulation);
+		else if (isBotPlaying)
+			events |= replayRecorder.Step(simulation, bot.GetInput(simulation));
 		else
-			return;
-	}
-
-	gravityPieceDeltaTime += deltaTime;
-	movementPieceDeltaTime += deltaTime;
+			events |= replayRecorder.Step(simulation, SimulationInput(input.down, pendingPressedInput));
 
-	lineClearTimeSeconds = std::max(1.0f - 0.1f * level, 0.1f);
+		pendingPressedInput = INPUT_NONE;
+	}
 
-	UpdatePieceRotation();
-	UpdatePieceMovement();
+	//a replay that stops before the game is over ends there
+	if (isWatchingReplay && replayPlayer.IsAtEnd() && !simulation.IsGameOver())
+		EndGame();
 
-	if (IsConfirmButtonPressed())
+	//only reported once, at the tick it went out of sync
+	if (isWatchingReplay && replayPlayer.GetDesyncTick() >= 0 && !hasReportedDesync)
 	{
-		HardDropPiece();
-		PlacePiece();
-
-		if (!CanPieceExistAt(currentPiece, currentPiecePosition))
-			EndGame();
+		std::cout << "Replay out of sync at tick " << replayPlayer.GetDesyncTick() << std::endl;
+		hasReportedDesync = true;
 	}
-	else if ((IsKeyPressed(KEY_C) || IsKeyPressed(KEY_LEFT_SHIFT) || IsKeyPressed(KEY_RIGHT_SHIFT)) && !hasSwitchedPiece)
-		HoldPiece();
-	else
-		UpdatePieceGravity();
-}
 
-void SceneGame::LineClearCheck(int topY, int bottomY)
-{
-	//check affected lines
-	for (int y = topY; y <= bottomY; y++)
+	if (events & EVENT_LINES_CLEARED)
 	{
-		bool isClear = true;
-
-		for (int x = 0; x < gameOptions.GridSize.x; x++)
-		{
-			if (grid[y][x].state != BLOCK_GRID)
-			{
-				isClear = false;
-				break;
-			}
-		}
-
-		if (isClear)
-		{
-			//start line clear animation for blocks
-			for (int x = 0; x < gameOptions.GridSize.x; x++)
-			{
-				grid[y][x].state = BLOCK_CLEARING;
-			}
+		GetSound("LineClear").Play();
 
-			clearingLines.push_back(y);
-			isClearingLines = true;
-		}
+		std::cout << "Cleared line(s), total: " + std::to_string(simulation.GetTotalLinesCleared()) << std::endl;
 	}
 
-	std::cout << "Checked lines " + std::to_string(topY) + " - " + std::to_string(bottomY) << std::endl;
+	if (events & EVENT_LEVEL_UP)
+		GetSound("LevelUp").Play();
 
-	if (isClearingLines)
+	if (events & EVENT_PIECE_PLACED)
 	{
-		deltaLineClearingTime = 0.0f;
-		std::cout << "Clearing " + std::to_string(clearingLines.size()) + " line(s) " << std::endl;
+		GetSound("PlacePiece").Play();
+
+		std::cout << "Placed piece!" << std::endl;
 	}
+
+	if (events & EVENT_PIECE_HELD)
+		std::cout << "Hold piece" << std::endl;
+
+	if (events & EVENT_GAME_OVER)
+		EndGame();
 }
 
 void SceneGame::UpdateGameOver()
 {
+	//attract mode plays game after game
+	if (isAttractMode)
+	{
+		StartGame();
+		return;
+	}
+
 	UpdateMenuButtonNagivation(0, 1);
 
 	switch (menuButtonIndex)
@@ -283,25 +327,64 @@ void SceneGame::UpdateGameOver()
 
 void SceneGame::EndGame()
 {
+	//games the bot plays on its own aren't worth keeping
+	if (!isWatchingReplay && !isAttractMode)
+	{
+		replayRecorder.Finish(simulation);
+
+		std::error_code errorCode;
+		std::filesystem::create_directories(REPLAY_DIRECTORY, errorCode);
+
+		std::string replayPath = std::string(REPLAY_DIRECTORY) + "/" + std::to_string(simulation.GetSeed()) + REPLAY_FILE_EXTENSION;
+
+		if (replayRecorder.GetReplay().SaveToFile(replayPath))
+			std::cout << "Saved replay: " << replayPath << std::endl;
+		else
+			std::cout << "Failed to save replay: " << replayPath << std::endl;
+	}
+
 	GetSound("GameOver").Play();
 	gameOver = true;
 	gamePaused = false;
 	menuButtonIndex = 0;
-	currentPiece = Piece();
 }
 
 void SceneGame::ReturnToMenu()
 {
+	isWatchingReplay = false;
+	isBotPlaying = false;
+	isAttractMode = false;
 	gameOver = false;
 	gamePaused = false;
 	menuState = MENU_TITLE;
 	menuButtonIndex = 0;
+	menuIdleSeconds = 0.0f;
 
 	//restart menu theme
 	raylib::Music& menuTheme = GetMusic("MenuTheme");
 	menuTheme.Seek(0.0f);
 }
 
+void SceneGame::StartAttractMode()
+{
+	std::cout << "Starting attract mode" << std::endl;
+
+	isAttractMode = true;
+	isBotPlaying = true;
+	menuState = MENU_NONE;
+	StartGame();
+}
+
+int SceneGame::GetBotNumThreads()
+{
+#ifdef PLATFORM_WEB
+	//web builds don't have threads
+	return 1;
+#else
+	return std::max((int)std::thread::hardware_concurrency(), 1);
+#endif
+}
+
 void SceneGame::DrawGame()
 {
 	const int UI_PIECE_LENGTH = 4;
@@ -314,6 +397,10 @@ void SceneGame::DrawGame()
 
 	raylib::Font& mainFont = GetFont("MainFont");
 
+	int level = simulation.GetLevel();
+	bool hasSwitchedPiece = simulation.HasSwitchedPiece();
+	const Piece& holdingPiece = simulation.GetHoldingPiece();
+
 	raylib::Color mainColor = raylib::Color::FromHSV(45.0f * (level - 1) + sinf((float)gameWindow.GetTime()) * 5.0f + 211.0f, 1.0f, 0.8f);
 
 	raylib::Color gridBackgroundColor = raylib::Color::Black().Alpha(0.6f);
@@ -325,7 +412,7 @@ void SceneGame::DrawGame()
 
 	if (gameOver)
 		borderColor = (Wrap((float)gameWindow.GetTime(), 0.0f, 0.5f) < 0.25f || !gameOptions.EnableStrobingLights) ? raylib::Color::Red() : borderColor;
-	else if (isClearingLines)
+	else if (simulation.IsClearingLines())
 		borderColor = raylib::Color(255 - borderColor.r, 255 - borderColor.g, 255 - borderColor.b, borderColor.a);
 
 	//Background
@@ -340,15 +427,21 @@ void SceneGame::DrawGame()
 
 	float maxFieldHeight = screenHeight - fieldYPadding * 2;
 
+	//Tall grids only show some of their rows, scrolling along with the current piece
+	const int MAX_VISIBLE_GRID_ROWS = 60;
+
+	int numVisibleGridRows = std::min(gameOptions.Rules.GridSize.y, MAX_VISIBLE_GRID_ROWS);
+	int firstVisibleGridRow = std::clamp(simulation.GetCurrentPiecePosition().y - numVisibleGridRows / 2, 0, gameOptions.Rules.GridSize.y - numVisibleGridRows);
+
 	//Grid size + Holding piece + Next pieces
 
-	float blockSize = std::min(maxFieldWidth / (gameOptions.GridSize.x + UI_PIECE_LENGTH * 2), maxFieldHeight / std::max(gameOptions.GridSize.y, UI_PIECE_LENGTH * gameOptions.NumUpAndComingPieces + gameOptions.NumUpAndComingPieces));
+	float blockSize = std::min(maxFieldWidth / (gameOptions.Rules.GridSize.x + UI_PIECE_LENGTH * 2), maxFieldHeight / std::max(numVisibleGridRows, UI_PIECE_LENGTH * gameOptions.Rules.NumUpAndComingPieces + gameOptions.Rules.NumUpAndComingPieces));
 
-	Vector2 fieldSize = { blockSize * (gameOptions.GridSize.x + UI_PIECE_LENGTH * 2), blockSize * gameOptions.GridSize.y };
+	Vector2 fieldSize = { blockSize * (gameOptions.Rules.GridSize.x + UI_PIECE_LENGTH * 2), blockSize * numVisibleGridRows };
 	float fieldX = ((float)screenWidth - fieldSize.x) / 2.0f;
 	float fieldY = ((float)screenHeight - fieldSize.y) / 2.0f;
 
-	Vector2 gridSize = { blockSize * gameOptions.GridSize.x, blockSize * gameOptions.GridSize.y };
+	Vector2 gridSize = { blockSize * gameOptions.Rules.GridSize.x, blockSize * numVisibleGridRows };
 	float gridX = ((float)screenWidth - gridSize.x) / 2.0f;
 
 	float aspectScale = std::min((float)fieldSize.x / DESIGN_WIDTH, (float)fieldSize.y / DESIGN_HEIGHT);
@@ -359,18 +452,18 @@ void SceneGame::DrawGame()
 		raylib::Rectangle(gridX, fieldY, gridSize.x, gridSize.y).Draw(gridBackgroundColor);
 
 		//Horizontal grid lines
-		for (int y = 1; y < gameOptions.GridSize.y; y++)
+		for (int y = 1; y < numVisibleGridRows; y++)
 		{
 			borderColor.Alpha(0.2f).DrawLine(Vector2{gridX, fieldY + y * blockSize}, Vector2{gridX + gridSize.x, fieldY + y * blockSize}, (int)(3.0f * aspectScale));
 		}
 
 		//Vertical grid lines
-		for (int x = 1; x < gameOptions.GridSize.x; x++)
+		for (int x = 1; x < gameOptions.Rules.GridSize.x; x++)
 		{
 			borderColor.Alpha(0.2f).DrawLine(Vector2{gridX + x * blockSize, fieldY}, Vector2{gridX + x * blockSize, fieldY + gridSize.y}, (int)(3.0f * aspectScale));
 		}
 
-		DrawGrid(gridX, fieldY, blockSize, blockTexture);
+		DrawGrid(gridX, fieldY, blockSize, blockTexture, firstVisibleGridRow, numVisibleGridRows);
 	}
 
 	//Draw pause overlay if paused
@@ -439,7 +532,7 @@ void SceneGame::DrawGame()
 		{
 			raylib::Rectangle rect = { holdPieceStartX + blockSize * (holdingPiece.blockOffsets[i].x + 1), fieldY + holdTextFontSize + blockSize * (holdingPiece.blockOffsets[i].y + 1), blockSize, blockSize };
 
-			blockTexture.Draw(blockTextureSource, rect, { 0.0f, 0.0f }, 0.0f, hasSwitchedPiece ? holdingPiece.blockColors[i].Alpha(0.5f) : holdingPiece.blockColors[i]);
+			blockTexture.Draw(blockTextureSource, rect, { 0.0f, 0.0f }, 0.0f, hasSwitchedPiece ? ToRaylibColor(BLOCK_PALETTE[holdingPiece.colorIndex]).Alpha(0.5f) : ToRaylibColor(BLOCK_PALETTE[holdingPiece.colorIndex]));
 		}
 	}
 
@@ -447,7 +540,7 @@ void SceneGame::DrawGame()
 	std::string nextText = "NEXT";
 	float nextTextFontSize = FitTextWidth(mainFont, nextText, (UI_PIECE_LENGTH - 1.0f) * blockSize, BASE_FONT_SPACING);
 
-	float nextHeight = blockSize * (UI_PIECE_LENGTH) * gameOptions.NumUpAndComingPieces + nextTextFontSize;
+	float nextHeight = blockSize * (UI_PIECE_LENGTH) * gameOptions.Rules.NumUpAndComingPieces + nextTextFontSize;
 
 	//Drawing next pieces
 	{
@@ -472,15 +565,17 @@ void SceneGame::DrawGame()
 
 		//Pieces
 		float nextPieceStartX = gridX + gridSize.x;
-		for (int pieceIndex = 0; pieceIndex < gameOptions.NumUpAndComingPieces; pieceIndex++)
+		for (int pieceIndex = 0; pieceIndex < gameOptions.Rules.NumUpAndComingPieces; pieceIndex++)
 		{
 			float pieceStartY = fieldY + nextTextFontSize + UI_PIECE_LENGTH * blockSize * pieceIndex;
 
-			for (int i = 0; i < upAndComingPieces[pieceIndex].numBlocks; i++)
+			Piece upAndComingPiece = simulation.GetRules().Pieces->GetPiece(simulation.GetUpAndComingPieceType(pieceIndex));
+
+			for (int i = 0; i < upAndComingPiece.numBlocks; i++)
 			{
-				raylib::Rectangle rect = { nextPieceStartX + blockSize * (upAndComingPieces[pieceIndex].blockOffsets[i].x + 1), pieceStartY + blockSize * (upAndComingPieces[pieceIndex].blockOffsets[i].y + 1), blockSize, blockSize };
+				raylib::Rectangle rect = { nextPieceStartX + blockSize * (upAndComingPiece.blockOffsets[i].x + 1), pieceStartY + blockSize * (upAndComingPiece.blockOffsets[i].y + 1), blockSize, blockSize };
 
-				blockTexture.Draw(blockTextureSource, rect, { 0.0f, 0.0f }, 0.0f, upAndComingPieces[pieceIndex].blockColors[i]);
+				blockTexture.Draw(blockTextureSource, rect, { 0.0f, 0.0f }, 0.0f, ToRaylibColor(BLOCK_PALETTE[upAndComingPiece.colorIndex]));
 			}
 		}
 
@@ -498,7 +593,7 @@ void SceneGame::DrawGame()
 		std::string scoreText = "SCORE";
 		mainFont.DrawText(scoreText, raylib::Vector2(fieldX + 0.5f * blockSize, fieldY + holdTextFontSize + blockSize * UI_PIECE_LENGTH + statPanelHeightPadding), statTextFontSize, statTextFontSize * BASE_FONT_SPACING, raylib::Color::White());
 
-		mainFont.DrawText(TextFormat("%06i", score), raylib::Vector2(fieldX + 0.5f * blockSize, fieldY + holdTextFontSize + blockSize * UI_PIECE_LENGTH + statTextFontSize + statPanelHeightPadding), statTextFontSize, statTextFontSize * BASE_FONT_SPACING, raylib::Color::White());
+		mainFont.DrawText(TextFormat("%06i", simulation.GetScore()), raylib::Vector2(fieldX + 0.5f * blockSize, fieldY + holdTextFontSize + blockSize * UI_PIECE_LENGTH + statTextFontSize + statPanelHeightPadding), statTextFontSize, statTextFontSize * BASE_FONT_SPACING, raylib::Color::White());
 
 		//Level
 		std::string levelText = "LEVEL";
@@ -510,13 +605,13 @@ void SceneGame::DrawGame()
 		std::string clearedText = "LINES";
 		mainFont.DrawText(clearedText, raylib::Vector2(fieldX + 0.5f * blockSize, fieldY + holdTextFontSize + blockSize * UI_PIECE_LENGTH + statTextFontSize * 4 + statPanelHeightPadding), statTextFontSize, statTextFontSize * BASE_FONT_SPACING, raylib::Color::White());
 	
-		mainFont.DrawText(TextFormat("%03i", totalLinesCleared), raylib::Vector2(fieldX + 0.5f * blockSize, fieldY + holdTextFontSize + blockSize * UI_PIECE_LENGTH + statTextFontSize * 5 + statPanelHeightPadding), statTextFontSize, statTextFontSize * BASE_FONT_SPACING, raylib::Color::White());
+		mainFont.DrawText(TextFormat("%03i", simulation.GetTotalLinesCleared()), raylib::Vector2(fieldX + 0.5f * blockSize, fieldY + holdTextFontSize + blockSize * UI_PIECE_LENGTH + statTextFontSize * 5 + statPanelHeightPadding), statTextFontSize, statTextFontSize * BASE_FONT_SPACING, raylib::Color::White());
 
 		//Time
 		std::string timeText = "TIME";
 		mainFont.DrawText(timeText, raylib::Vector2(fieldX + 0.5f * blockSize, fieldY + holdTextFontSize + blockSize * UI_PIECE_LENGTH + statTextFontSize * 6 + statPanelHeightPadding), statTextFontSize, statTextFontSize * BASE_FONT_SPACING, raylib::Color::White());
 
-		mainFont.DrawText(TextFormat("%03.0f", timePlayingSeconds), raylib::Vector2(fieldX + 0.5f * blockSize, fieldY + holdTextFontSize + blockSize * UI_PIECE_LENGTH + statTextFontSize * 7 + statPanelHeightPadding), statTextFontSize, statTextFontSize * BASE_FONT_SPACING, raylib::Color::White());
+		mainFont.DrawText(TextFormat("%03.0f", simulation.GetTimePlayingSeconds()), raylib::Vector2(fieldX + 0.5f * blockSize, fieldY + holdTextFontSize + blockSize * UI_PIECE_LENGTH + statTextFontSize * 7 + statPanelHeightPadding), statTextFontSize, statTextFontSize * BASE_FONT_SPACING, raylib::Color::White());
 	}
 
 	//TODO: should the lines here be moved into each part's own sections instead of all be clumped here?
@@ -544,368 +639,50 @@ void SceneGame::DrawGame()
 
 #pragma endregion
 
-#pragma region Pieces
-
-Piece SceneGame::GetRandomPiece()
-{
-	return Piece::GetMainPiece((MainPieceType)GetRandomValue(0, 6));
-}
-
-bool SceneGame::CanPieceExistAt(Piece piece, Vector2Int position)
-{
-	//if any block is out of bounds or not empty, then the piece can not exist at this position
-	for (int i = 0; i < piece.numBlocks; i++)
-	{
-		if (!IsCellEmpty(position.x + piece.blockOffsets[i].x, position.y + piece.blockOffsets[i].y))
-			return false;
-	}
-
-	return true;
-}
-
-void SceneGame::RefillBag()
-{
-	bagPieces.clear();
-
-	for (int i = 0; i < 7; i++)
-		bagPieces.emplace_back(Piece::GetMainPiece((MainPieceType)i));
-
-	std::cout << "Refilled bag" << std::endl;
-}
-
-Piece SceneGame::GetRandomPieceFromBag()
-{
-	//refill bag if empty
-	if (bagPieces.size() == 0)
-		RefillBag();
-
-	int bagIndex = GetRandomValue(0, (int)bagPieces.size() - 1);
-
-	Piece piece = bagPieces[bagIndex];
-
-	//remove piece from bag
-	bagPieces.erase(std::next(bagPieces.begin(), bagIndex));
-
-	return piece;
-}
-
-void SceneGame::NextPiece()
-{
-	//get next piece in line
-	currentPiece = upAndComingPieces[0];
-
-	//move up and coming pieces downwards
-	for (int i = 0; i < gameOptions.NumUpAndComingPieces - 1; i++)
-		upAndComingPieces[i] = upAndComingPieces[i + 1];
-
-	//fill last spot with random piece from bag
-	upAndComingPieces[gameOptions.NumUpAndComingPieces - 1] = GetRandomPieceFromBag();
-
-	currentPiecePosition = { gameOptions.GridSize.x / 2 , 0 };
-
-	gravityPieceDeltaTime = 0.0f;
-
-	std::cout << "next piece in line" << std::endl;
-}
-
-void SceneGame::PlacePiece()
-{
-	int topPieceY = INT32_MAX;
-	int bottomPieceY = INT32_MIN;
-
-	//Place piece into grid
-	for (int i = 0; i < currentPiece.numBlocks; i++)
-	{
-		if (!IsCellInBounds(currentPiecePosition.x + currentPiece.blockOffsets[i].x, currentPiecePosition.y + currentPiece.blockOffsets[i].y))
-			continue;
-
-		if (currentPiece.blockOffsets[i].y > bottomPieceY)
-			bottomPieceY = currentPiece.blockOffsets[i].y;
-
-		if (currentPiece.blockOffsets[i].y < topPieceY)
-			topPieceY = currentPiece.blockOffsets[i].y;
-
-		grid[currentPiecePosition.y + currentPiece.blockOffsets[i].y][currentPiecePosition.x + currentPiece.blockOffsets[i].x].color = currentPiece.blockColors[i];
-		grid[currentPiecePosition.y + currentPiece.blockOffsets[i].y][currentPiecePosition.x + currentPiece.blockOffsets[i].x].state = BLOCK_GRID;
-	}
-
-	hasSwitchedPiece = false;
-
-	std::cout << "Placed piece!" << std::endl;
-
-	//Checks for cleared lines
-	LineClearCheck(currentPiecePosition.y + topPieceY, currentPiecePosition.y + bottomPieceY);
-
-	GetSound("PlacePiece").Play();
-
-	NextPiece();
-}
-
-void SceneGame::HoldPiece()
-{
-	Piece tempPiece = holdingPiece;
-
-	holdingPiece = currentPiece;
-
-	//Go to next piece if we weren't holding a piece yet
-	if (tempPiece.numBlocks == 0)
-		NextPiece();
-	//Swap held piece out into current piece
-	else
-		currentPiece = tempPiece;
-
-	currentPiecePosition = { gameOptions.GridSize.x / 2 , 0 };
-	gravityPieceDeltaTime = 0.0f;
-	hasSwitchedPiece = true;
-
-	std::cout << "Hold piece" << std::endl;
-}
-
-void SceneGame::HardDropPiece()
-{
-	int cellsMoved = 0;
-
-	//Instantly move piece downwards until it can't anymore
-	while (CanPieceExistAt(currentPiece, { currentPiecePosition.x, currentPiecePosition.y + 1 }))
-	{
-		currentPiecePosition = { currentPiecePosition.x, currentPiecePosition.y + 1 };
-		cellsMoved++;
-	}
-
-	score += cellsMoved * 2;
-
-	std::cout << "Hard drop piece (" + std::to_string(cellsMoved) + " cells, +" + std::to_string(cellsMoved * 2) + " points)" << std::endl;
-}
-
-void SceneGame::UpdatePieceRotation()
-{
-	Piece piece = currentPiece;
-
-	//rotation
-	if (IsKeyPressed(KEY_LEFT_CONTROL) || IsKeyPressed(KEY_RIGHT_CONTROL) || IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_E))
-		piece = piece.GetCounterClockwiseRotation(); //Counter-clockwise
-	else if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_X) || IsKeyPressed(KEY_R) || IsKeyPressed(KEY_W))
-		piece = piece.GetClockwiseRotation(); //Clockwise
-	else if (IsKeyPressed(KEY_T))
-		piece = piece.GetHalfCircleRotation();
-	else
-		return;
-
-	//If rotated piece can exist here, set current piece to rotated form of current piece without moving it
-	if (CanPieceExistAt(piece, currentPiecePosition))
-	{
-		currentPiece = piece;
-		return;
-	}
-
-	//Slightly move the piece if necessary and possible, allowing for rotation when near the border or other blocks without getting stuck
-	//The amount of blocks that the piece needs to be moved depends on 
-	//how many columns (x) contained in non-empty spots if the piece had been rotated without being moved at all
-
-	int leftNonEmptyX = INT32_MAX;
-	int rightNonEmptyX = INT32_MIN;
-
-	for (int i = 0; i < piece.numBlocks; i++)
-	{
-		if (IsCellEmpty(currentPiecePosition.x + piece.blockOffsets[i].x, currentPiecePosition.y + piece.blockOffsets[i].y))
-			continue;
-
-		if (piece.blockOffsets[i].x < leftNonEmptyX)
-			leftNonEmptyX = piece.blockOffsets[i].x;
-
-		if (piece.blockOffsets[i].x > rightNonEmptyX)
-			rightNonEmptyX = piece.blockOffsets[i].x;
-	}
-
-	int nonEmptyWidth = abs(leftNonEmptyX - rightNonEmptyX) + 1;
-
-	if (CanPieceExistAt(piece, Vector2Int{ currentPiecePosition.x - nonEmptyWidth, currentPiecePosition.y }))
-	{
-		currentPiecePosition = Vector2Int{ currentPiecePosition.x - nonEmptyWidth, currentPiecePosition.y };
-		currentPiece = piece;
-	}
-	else if (CanPieceExistAt(piece, Vector2Int{ currentPiecePosition.x + nonEmptyWidth, currentPiecePosition.y }))
-	{
-		currentPiecePosition = Vector2Int{ currentPiecePosition.x + nonEmptyWidth, currentPiecePosition.y };
-		currentPiece = piece;
-	}
-}
-
-void SceneGame::UpdatePieceMovement()
-{
-	//movement
-	Vector2Int movement = { 0, 0 };
-	const float movePieceTime = 1.0f / 10.0f;
-
-	if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D))
-	{
-		movement.x = 1;
-
-		if (IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D))
-		{
-			if (CanPieceExistAt(currentPiece, Vector2Int{ currentPiecePosition.x + 1, currentPiecePosition.y }))
-				currentPiecePosition = Vector2Int{ currentPiecePosition.x + 1, currentPiecePosition.y };
-
-			movementPieceDeltaTime = -movePieceTime; //extra delay before repeated movements
-		}
-	}
-	else if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A))
-	{
-		movement.x = -1;
-
-		if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A))
-		{
-			if (CanPieceExistAt(currentPiece, Vector2Int{ currentPiecePosition.x - 1, currentPiecePosition.y }))
-				currentPiecePosition = Vector2Int{ currentPiecePosition.x - 1, currentPiecePosition.y };
-
-			movementPieceDeltaTime = -movePieceTime; //extra delay before repeated movements
-		}
-	}
-
-	if ((IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A) || IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) && movementPieceDeltaTime >= movePieceTime)
-	{
-		while (movementPieceDeltaTime >= movePieceTime)
-		{
-			movementPieceDeltaTime -= movePieceTime;
-
-			Vector2Int newPiecePosition = { currentPiecePosition.x + movement.x, currentPiecePosition.y + movement.y };
-
-			if (CanPieceExistAt(currentPiece, newPiecePosition))
-				currentPiecePosition = newPiecePosition;
-			else
-				break;
-		}
-	}
-}
-
-void SceneGame::UpdatePieceGravity()
-{
-	if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S))
-		gravityPieceDeltaTime = 1.0f / 20.0f;
-
-	int gravityLevel = std::min(level - 1, 14);
-
-	float gravityMovementTime = (float)std::pow(0.8f - ((float)gravityLevel * 0.007f), (float)gravityLevel);
-
-	//Soft drop speed
-	if ((IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S)) && gravityMovementTime > 1.0f / 20.0f)
-		gravityMovementTime = 1.0f / 20.0f;
-
-	while (gravityPieceDeltaTime >= gravityMovementTime)
-	{
-		gravityPieceDeltaTime -= gravityMovementTime;
-
-		if (CanPieceExistAt(currentPiece, { currentPiecePosition.x, currentPiecePosition.y + 1 }))
-		{
-			currentPiecePosition = { currentPiecePosition.x, currentPiecePosition.y + 1 };
-
-			//plus one point for each cell dropped with soft drop
-			if (IsKeyDown(KEY_DOWN))
-				score += 1;
-		}
-		else
-		{
-			PlacePiece();
-			break;
-		}
-	}
-
-	if (!CanPieceExistAt(currentPiece, currentPiecePosition))
-		EndGame();
-}
-
-#pragma endregion
-
 #pragma region Grid
 
-bool SceneGame::IsCellInBounds(int x, int y) const
-{
-	return x >= 0 && x < gameOptions.GridSize.x && y >= 0 && y < gameOptions.GridSize.y;
-}
-
-//Out of bounds cells do not count as empty and thus return false, unless this cell is above the grid but still within the left and right bounds.
-bool SceneGame::IsCellEmpty(int x, int y)
-{
-	if (x < 0 || x >= gameOptions.GridSize.x || y >= gameOptions.GridSize.y)
-		return false;
-
-	if (y < 0)
-		return true;
-
-	return grid[y][x].state == BLOCK_EMPTY;
-}
-
 void SceneGame::SetGridSize(Vector2Int gridSize)
 {
-	//Delete old grid
-	if (grid != nullptr)
-	{
-		for (int y = 0; y < gameOptions.GridSize.y; y++)
-			delete[] grid[y];
-
-		delete[] grid;
-	}
-
-	gameOptions.GridSize = gridSize;
+	gameOptions.Rules.GridSize = gridSize;
 
-	//Create grid
-	grid = new BlockCell * [gridSize.y];
-	for (int y = 0; y < gridSize.y; y++)
-	{
-		grid[y] = new BlockCell[gridSize.x];
-
-		for (int x = 0; x < gridSize.x; x++)
-		{
-			grid[y][x] = BlockCell(BLOCK_EMPTY, raylib::Color::Blank());
-		}
-	}
+	simulation.SetRules(gameOptions.Rules);
 }
 
-void SceneGame::ClearLine(int line)
+//Only draws the rows from firstRow up to firstRow + numRows, with firstRow at posY
+void SceneGame::DrawGrid(float posX, float posY, float blockSize, raylib::Texture2D& blockTexture, int firstRow, int numRows)
 {
-	//shift everything downwards
-	for (int y = line; y > 0; y--)
-	{
-		for (int x = 0; x < gameOptions.GridSize.x; x++)
-		{
-			grid[y][x] = grid[y - 1][x];
-		}
-	}
+	raylib::Rectangle blockTextureSource = { 0.0f, 0.0f, (float)blockTexture.width, (float)blockTexture.height };
 
-	//clear line 0
-	for (int x = 0; x < gameOptions.GridSize.x; x++)
-		grid[0][x].state = BLOCK_EMPTY;
-	
-	std::cout << "Cleared line " + std::to_string(line) << std::endl;
-}
+	const Board& board = simulation.GetBoard();
 
-void SceneGame::DrawGrid(float posX, float posY, float blockSize, raylib::Texture2D& blockTexture)
-{
-	raylib::Rectangle blockTextureSource = { 0.0f, 0.0f, (float)blockTexture.width, (float)blockTexture.height };
+	float lineClearTimeSeconds = simulation.GetLineClearTimeSeconds();
+	float deltaLineClearingTime = simulation.GetLineClearingTime();
 
 	//Draw grid cells
-	for (int gridY = 0; gridY < gameOptions.GridSize.y; gridY++)
+	for (int gridY = firstRow; gridY < firstRow + numRows; gridY++)
 	{
-		for (int gridX = 0; gridX < gameOptions.GridSize.x; gridX++)
+		for (int gridX = 0; gridX < gameOptions.Rules.GridSize.x; gridX++)
 		{
-			if (grid[gridY][gridX].state == BLOCK_EMPTY)
+			const BlockCell& cell = board.GetCell(gridX, gridY);
+
+			if (cell.state == BLOCK_EMPTY)
 				continue;
 
-			raylib::Rectangle rect = { posX + blockSize * gridX, posY + blockSize * gridY, blockSize, blockSize };
-			raylib::Color blockColor = grid[gridY][gridX].color;
+			raylib::Rectangle rect = { posX + blockSize * gridX, posY + blockSize * (gridY - firstRow), blockSize, blockSize };
+			raylib::Color blockColor = ToRaylibColor(BLOCK_PALETTE[cell.colorIndex]);
 
 
-			switch (grid[gridY][gridX].state)
+			switch (cell.state)
 			{
 				case BLOCK_GRID:
 					blockTexture.Draw(blockTextureSource, rect, { 0.0f, 0.0f }, 0.0f, blockColor);
 					break;
 				case BLOCK_CLEARING:
 				{
-					const int FLASH_LENGTH = std::min(6, gameOptions.GridSize.x);
+					const int FLASH_LENGTH = std::min(6, gameOptions.Rules.GridSize.x);
 
-					float startFlashTime = (lineClearTimeSeconds - (lineClearTimeSeconds / gameOptions.GridSize.x) * (FLASH_LENGTH - 2)) / gameOptions.GridSize.x * (gridX);
-					float endFlashTime = (lineClearTimeSeconds - (lineClearTimeSeconds / gameOptions.GridSize.x) * (FLASH_LENGTH - 2)) / gameOptions.GridSize.x * (gridX + FLASH_LENGTH);
+					float startFlashTime = (lineClearTimeSeconds - (lineClearTimeSeconds / gameOptions.Rules.GridSize.x) * (FLASH_LENGTH - 2)) / gameOptions.Rules.GridSize.x * (gridX);
+					float endFlashTime = (lineClearTimeSeconds - (lineClearTimeSeconds / gameOptions.Rules.GridSize.x) * (FLASH_LENGTH - 2)) / gameOptions.Rules.GridSize.x * (gridX + FLASH_LENGTH);
 
 					if (deltaLineClearingTime < endFlashTime)
 						blockTexture.Draw(blockTextureSource, rect, { 0.0f, 0.0f }, 0.0f, deltaLineClearingTime >= startFlashTime ? raylib::Color::White() : blockColor);
@@ -918,38 +695,39 @@ void SceneGame::DrawGrid(float posX, float posY, float blockSize, raylib::Textur
 		}
 	}
 
-	if (!gameOver && !isClearingLines)
+	if (!gameOver && !simulation.IsClearingLines())
 	{
+		const Piece& currentPiece = simulation.GetCurrentPiece();
+		Vector2Int currentPiecePosition = simulation.GetCurrentPiecePosition();
+
 		//Draw current piece
 		for (int i = 0; i < currentPiece.numBlocks; i++)
 		{
-			if (!IsCellInBounds(currentPiecePosition.x + currentPiece.blockOffsets[i].x, currentPiecePosition.y + currentPiece.blockOffsets[i].y))
+			int blockY = currentPiecePosition.y + currentPiece.blockOffsets[i].y;
+
+			if (!board.IsCellInBounds(currentPiecePosition.x + currentPiece.blockOffsets[i].x, blockY) || blockY < firstRow || blockY >= firstRow + numRows)
 				continue;
 
-			raylib::Rectangle rect = { posX + blockSize * (currentPiecePosition.x + currentPiece.blockOffsets[i].x), posY + blockSize * (currentPiecePosition.y + currentPiece.blockOffsets[i].y), blockSize, blockSize };
+			raylib::Rectangle rect = { posX + blockSize * (currentPiecePosition.x + currentPiece.blockOffsets[i].x), posY + blockSize * (blockY - firstRow), blockSize, blockSize };
 
-			blockTexture.Draw(blockTextureSource, rect, { 0.0f, 0.0f }, 0.0f, currentPiece.blockColors[i]);
+			blockTexture.Draw(blockTextureSource, rect, { 0.0f, 0.0f }, 0.0f, ToRaylibColor(BLOCK_PALETTE[currentPiece.colorIndex]));
 		}
 
 		if (gameOptions.ShowGhostPiece && currentPiece.numBlocks != 0)
 		{
-			//Draw current piece preview
-			Vector2Int previewPosition = currentPiecePosition;
-
-			//move preview position downwards until it hits the grid
-			while (CanPieceExistAt(currentPiece, { previewPosition.x, previewPosition.y + 1 }))
-			{
-				previewPosition = { previewPosition.x, previewPosition.y + 1 };
-			}
+			//Draw current piece preview where it would land
+			Vector2Int previewPosition = simulation.GetDropPosition();
 
 			for (int i = 0; i < currentPiece.numBlocks; i++)
 			{
-				if (!IsCellInBounds(previewPosition.x + currentPiece.blockOffsets[i].x, previewPosition.y + currentPiece.blockOffsets[i].y))
+				int blockY = previewPosition.y + currentPiece.blockOffsets[i].y;
+
+				if (!board.IsCellInBounds(previewPosition.x + currentPiece.blockOffsets[i].x, blockY) || blockY < firstRow || blockY >= firstRow + numRows)
 					continue;
 
-				raylib::Rectangle rect = { posX + blockSize * (previewPosition.x + currentPiece.blockOffsets[i].x), posY + blockSize * (previewPosition.y + currentPiece.blockOffsets[i].y), blockSize, blockSize };
+				raylib::Rectangle rect = { posX + blockSize * (previewPosition.x + currentPiece.blockOffsets[i].x), posY + blockSize * (blockY - firstRow), blockSize, blockSize };
 
-				blockTexture.Draw(blockTextureSource, rect, { 0.0f, 0.0f }, 0.0f, Fade(currentPiece.blockColors[i], 0.3f));
+				blockTexture.Draw(blockTextureSource, rect, { 0.0f, 0.0f }, 0.0f, Fade(ToRaylibColor(BLOCK_PALETTE[currentPiece.colorIndex]), 0.3f));
 			}
 		}
 	}
@@ -988,6 +766,18 @@ void SceneGame::UpdateTitleMenu()
 
 	UpdateMenuButtonNagivation(0, numButtons - 1);
 
+	//the bot shows the game off once nobody has touched the keyboard for a while
+	if (GetKeyPressed() != 0)
+		menuIdleSeconds = 0.0f;
+	else
+		menuIdleSeconds += gameWindow.GetFrameTime();
+
+	if (menuIdleSeconds >= ATTRACT_MODE_IDLE_SECONDS)
+	{
+		StartAttractMode();
+		return;
+	}
+
 	switch (menuButtonIndex)
 	{
 		//start button
@@ -1034,7 +824,7 @@ void SceneGame::UpdateTitleMenu()
 
 void SceneGame::UpdateOptionsMenu()
 {
-	UpdateMenuButtonNagivation(0, 5);
+	UpdateMenuButtonNagivation(0, NUM_OPTIONS);
 
 	switch (menuButtonIndex)
 	{
@@ -1060,17 +850,17 @@ void SceneGame::UpdateOptionsMenu()
 
 			if (IsConfirmButtonPressed() || IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D))
 			{
-				if (gameOptions.GridSize.x + 1 > MAX_GRID_WIDTH)
-					SetGridSize(Vector2Int{ MIN_GRID_WIDTH, gameOptions.GridSize.y });
+				if (gameOptions.Rules.GridSize.x + 1 > MAX_GRID_WIDTH)
+					SetGridSize(Vector2Int{ MIN_GRID_WIDTH, gameOptions.Rules.GridSize.y });
 				else
-					SetGridSize(Vector2Int{ gameOptions.GridSize.x + 1, gameOptions.GridSize.y });
+					SetGridSize(Vector2Int{ gameOptions.Rules.GridSize.x + 1, gameOptions.Rules.GridSize.y });
 			}
 			else if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A))
 			{
-				if (gameOptions.GridSize.x - 1 < MIN_GRID_WIDTH)
-					SetGridSize(Vector2Int{ MAX_GRID_WIDTH, gameOptions.GridSize.y });
+				if (gameOptions.Rules.GridSize.x - 1 < MIN_GRID_WIDTH)
+					SetGridSize(Vector2Int{ MAX_GRID_WIDTH, gameOptions.Rules.GridSize.y });
 				else
-					SetGridSize(Vector2Int{ gameOptions.GridSize.x - 1, gameOptions.GridSize.y });
+					SetGridSize(Vector2Int{ gameOptions.Rules.GridSize.x - 1, gameOptions.Rules.GridSize.y });
 			}
 
 			break;
@@ -1078,22 +868,30 @@ void SceneGame::UpdateOptionsMenu()
 		//grid height option
 		case 3:
 		{
-			const int MAX_GRID_HEIGHT = 60;
+			//heights above HUGE_GRID_HEIGHT are experimental and double with each step
+			const int HUGE_GRID_HEIGHT = 60;
+			const int MAX_GRID_HEIGHT = HUGE_GRID_HEIGHT * 128;
 			const int MIN_GRID_HEIGHT = 16;
 
+			int gridHeight = gameOptions.Rules.GridSize.y;
+
 			if (IsConfirmButtonPressed() || IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D))
 			{
-				if (gameOptions.GridSize.y + 1 > MAX_GRID_HEIGHT)
-					SetGridSize(Vector2Int{ gameOptions.GridSize.x, MIN_GRID_HEIGHT });
+				int nextGridHeight = (gridHeight >= HUGE_GRID_HEIGHT) ? gridHeight * 2 : gridHeight + 1;
+
+				if (nextGridHeight > MAX_GRID_HEIGHT)
+					SetGridSize(Vector2Int{ gameOptions.Rules.GridSize.x, MIN_GRID_HEIGHT });
 				else
-					SetGridSize(Vector2Int{ gameOptions.GridSize.x, gameOptions.GridSize.y + 1 });
+					SetGridSize(Vector2Int{ gameOptions.Rules.GridSize.x, nextGridHeight });
 			}
 			else if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A))
 			{
-				if (gameOptions.GridSize.y - 1 < MIN_GRID_HEIGHT)
-					SetGridSize(Vector2Int{ gameOptions.GridSize.x, MAX_GRID_HEIGHT });
+				int previousGridHeight = (gridHeight > HUGE_GRID_HEIGHT) ? gridHeight / 2 : gridHeight - 1;
+
+				if (previousGridHeight < MIN_GRID_HEIGHT)
+					SetGridSize(Vector2Int{ gameOptions.Rules.GridSize.x, MAX_GRID_HEIGHT });
 				else
-					SetGridSize(Vector2Int{ gameOptions.GridSize.x, gameOptions.GridSize.y - 1 });
+					SetGridSize(Vector2Int{ gameOptions.Rules.GridSize.x, previousGridHeight });
 			}
 
 			break;
@@ -1105,8 +903,73 @@ void SceneGame::UpdateOptionsMenu()
 				gameOptions.ShowGhostPiece = !gameOptions.ShowGhostPiece;
 			}
 			break;
-		//back button
+		//randomizer option
 		case 5:
+			if (IsConfirmButtonPressed() || IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D))
+			{
+				gameOptions.Rules.Randomizer = (RandomizerType)((gameOptions.Rules.Randomizer + 1) % NUM_RANDOMIZER_TYPES);
+				simulation.SetRules(gameOptions.Rules);
+			}
+			else if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A))
+			{
+				gameOptions.Rules.Randomizer = (RandomizerType)((gameOptions.Rules.Randomizer + NUM_RANDOMIZER_TYPES - 1) % NUM_RANDOMIZER_TYPES);
+				simulation.SetRules(gameOptions.Rules);
+			}
+			break;
+		//piece set option
+		case 6:
+		{
+			const std::vector<std::shared_ptr<const PieceSet>>& pieceSets = GetPieceSets();
+			int numPieceSets = (int)pieceSets.size();
+
+			int pieceSetIndex = 0;
+
+			for (int i = 0; i < numPieceSets; i++)
+			{
+				if (pieceSets[i] == gameOptions.Rules.Pieces)
+					pieceSetIndex = i;
+			}
+
+			if (IsConfirmButtonPressed() || IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D))
+			{
+				gameOptions.Rules.Pieces = pieceSets[(pieceSetIndex + 1) % numPieceSets];
+				simulation.SetRules(gameOptions.Rules);
+			}
+			else if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A))
+			{
+				gameOptions.Rules.Pieces = pieceSets[(pieceSetIndex + numPieceSets - 1) % numPieceSets];
+				simulation.SetRules(gameOptions.Rules);
+			}
+			break;
+		}
+		//rotation system option
+		case 7:
+			if (IsConfirmButtonPressed() || IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D))
+			{
+				gameOptions.Rules.RotationSystem = (RotationSystemType)((gameOptions.Rules.RotationSystem + 1) % NUM_ROTATION_SYSTEM_TYPES);
+				simulation.SetRules(gameOptions.Rules);
+			}
+			else if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A))
+			{
+				gameOptions.Rules.RotationSystem = (RotationSystemType)((gameOptions.Rules.RotationSystem + NUM_ROTATION_SYSTEM_TYPES - 1) % NUM_ROTATION_SYSTEM_TYPES);
+				simulation.SetRules(gameOptions.Rules);
+			}
+			break;
+		//gravity option
+		case 8:
+			if (IsConfirmButtonPressed() || IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D))
+			{
+				gameOptions.Rules.Gravity = (GravityType)((gameOptions.Rules.Gravity + 1) % NUM_GRAVITY_TYPES);
+				simulation.SetRules(gameOptions.Rules);
+			}
+			else if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A))
+			{
+				gameOptions.Rules.Gravity = (GravityType)((gameOptions.Rules.Gravity + NUM_GRAVITY_TYPES - 1) % NUM_GRAVITY_TYPES);
+				simulation.SetRules(gameOptions.Rules);
+			}
+			break;
+		//back button
+		case NUM_OPTIONS:
 			if (IsConfirmButtonPressed())
 			{
 				menuState = MENU_TITLE;
@@ -1268,44 +1131,64 @@ void SceneGame::DrawOptionsMenu()
 		titleTextX += titleCharWidth + (titleTextSize / 10);
 	}
 
-	//Options
+	//Options, the list scrolls to keep the selected option in view
 	float optionTextSize = 40 * aspectScale;
 
+	int firstVisibleOption = std::clamp(menuButtonIndex - NUM_VISIBLE_OPTIONS / 2, 0, NUM_OPTIONS - NUM_VISIBLE_OPTIONS);
+
+	auto drawOption = [&](const std::string& optionText, int optionIndex)
+	{
+		int visibleIndex = optionIndex - firstVisibleOption;
+
+		if (visibleIndex < 0 || visibleIndex >= NUM_VISIBLE_OPTIONS)
+			return;
+
+		float optionTextWidth = mainFont.MeasureText(optionText, optionTextSize, optionTextSize * BASE_FONT_SPACING).x;
+		mainFont.DrawText(optionText, raylib::Vector2(screenWidth / 2.0f - optionTextWidth / 2.0f, screenHeight / 2.0f + optionTextSize * visibleIndex - optionTextSize / 2.0f), optionTextSize, optionTextSize * BASE_FONT_SPACING, menuButtonIndex == optionIndex ? raylib::Color::Yellow() : raylib::Color::LightGray());
+	};
+
 	//MUSIC
 	std::string musicText = "MUSIC: ";
 	musicText += gameOptions.PlayMusic ? "ON" : "OFF";
 
-	float musicTextWidth = mainFont.MeasureText(musicText, optionTextSize, optionTextSize * BASE_FONT_SPACING).x;
-	mainFont.DrawText(musicText, raylib::Vector2(screenWidth / 2.0f - musicTextWidth / 2.0f, screenHeight / 2.0f - optionTextSize / 2.0f), optionTextSize, optionTextSize * BASE_FONT_SPACING, menuButtonIndex == 0 ? raylib::Color::Yellow() : raylib::Color::LightGray());
+	drawOption(musicText, 0);
 
 	//Strobing lights
 	std::string strobingLightsText = "STROBING LIGHTS: ";
 	strobingLightsText += gameOptions.EnableStrobingLights ? "ON" : "OFF";
 
-	float strobingLightsWidth = mainFont.MeasureText(strobingLightsText, optionTextSize, optionTextSize * BASE_FONT_SPACING).x;
-	mainFont.DrawText(strobingLightsText, raylib::Vector2(screenWidth / 2.0f - strobingLightsWidth / 2.0f, screenHeight / 2.0f + optionTextSize - optionTextSize / 2.0f), optionTextSize, optionTextSize * BASE_FONT_SPACING, menuButtonIndex == 1 ? raylib::Color::Yellow() : raylib::Color::LightGray());
+	drawOption(strobingLightsText, 1);
 
 	//Width
-	float widthTextWidth = mainFont.MeasureText(TextFormat("WIDTH: < %i >", gameOptions.GridSize.x), optionTextSize, optionTextSize * BASE_FONT_SPACING).x;
-	mainFont.DrawText(TextFormat("WIDTH: < %i >", gameOptions.GridSize.x), raylib::Vector2(screenWidth / 2.0f - widthTextWidth / 2.0f, screenHeight / 2.0f + optionTextSize * 2 - optionTextSize / 2.0f), optionTextSize, optionTextSize * BASE_FONT_SPACING, menuButtonIndex == 2 ? raylib::Color::Yellow() : raylib::Color::LightGray());
+	drawOption(TextFormat("WIDTH: < %i >", gameOptions.Rules.GridSize.x), 2);
 
 	//Height
-	float heightTextWidth = mainFont.MeasureText(TextFormat("HEIGHT: < %i >", gameOptions.GridSize.y), optionTextSize, optionTextSize * BASE_FONT_SPACING).x;
-	mainFont.DrawText(TextFormat("HEIGHT: < %i >", gameOptions.GridSize.y), raylib::Vector2(screenWidth / 2.0f - heightTextWidth / 2.0f, screenHeight / 2.0f + optionTextSize * 3 - optionTextSize / 2.0f), optionTextSize, optionTextSize * BASE_FONT_SPACING, menuButtonIndex == 3 ? raylib::Color::Yellow() : raylib::Color::LightGray());
+	drawOption(TextFormat("HEIGHT: < %i >", gameOptions.Rules.GridSize.y), 3);
 
 	//Show ghost piece
 	std::string ghostPieceText = "GHOST PIECE: ";
 	ghostPieceText += gameOptions.ShowGhostPiece ? "ON" : "OFF";
 
-	float ghostPieceTextWidth = mainFont.MeasureText(ghostPieceText, optionTextSize, optionTextSize * BASE_FONT_SPACING).x;
-	mainFont.DrawText(ghostPieceText, raylib::Vector2(screenWidth / 2.0f - ghostPieceTextWidth / 2.0f, screenHeight / 2.0f + optionTextSize * 4 - optionTextSize / 2.0f), optionTextSize, optionTextSize * BASE_FONT_SPACING, menuButtonIndex == 4 ? raylib::Color::Yellow() : raylib::Color::LightGray());
+	drawOption(ghostPieceText, 4);
+
+	//Randomizer
+	drawOption(TextFormat("RANDOMIZER: < %s >", GetRandomizerTypeName(gameOptions.Rules.Randomizer)), 5);
+
+	//Piece set
+	drawOption(TextFormat("PIECES: < %s >", gameOptions.Rules.Pieces->GetName().c_str()), 6);
+
+	//Rotation system
+	drawOption(TextFormat("ROTATION: < %s >", GetRotationSystemTypeName(gameOptions.Rules.RotationSystem)), 7);
+
+	//Gravity
+	drawOption(TextFormat("GRAVITY: < %s >", GetGravityTypeName(gameOptions.Rules.Gravity)), 8);
 
 	//Buttons
 	float buttonTextSize = 52 * aspectScale;
 
 	std::string backText = "BACK";
 	float backWidth = mainFont.MeasureText(backText, buttonTextSize, buttonTextSize * BASE_FONT_SPACING).x;
-	mainFont.DrawText(backText, raylib::Vector2(screenWidth / 2.0f - backWidth / 2.0f, screenHeight / 2.0f + buttonTextSize * 4 - buttonTextSize / 2.0f), buttonTextSize, buttonTextSize * BASE_FONT_SPACING, menuButtonIndex == 5 ? raylib::Color::Yellow() : raylib::Color::LightGray());
+	mainFont.DrawText(backText, raylib::Vector2(screenWidth / 2.0f - backWidth / 2.0f, screenHeight / 2.0f + buttonTextSize * 4 - buttonTextSize / 2.0f), buttonTextSize, buttonTextSize * BASE_FONT_SPACING, menuButtonIndex == NUM_OPTIONS ? raylib::Color::Yellow() : raylib::Color::LightGray());
 
 	DrawBuildInfo();
 }
@@ -1348,7 +1231,7 @@ void SceneGame::DrawControlsMenu()
 	//Controls
 	float controlsTextSize = 24 * aspectScale;
 
-	std::string controlsText = "LEFT - Left/A | RIGHT - Right/D\nCLOCKWISE ROTATE - Up/W/X/R\nCOUNTER-CLOCKWISE ROTATE - L Ctrl/R Ctrl/Z/E\n180 DEG ROTATE - T\nSOFT DROP - Down/S\nHARD DROP/CONFIRM - Space/Enter\nHOLD - C/Left Shift/Right Shift\nPAUSE - ESC/F1";
+	std::string controlsText = "LEFT - Left/A | RIGHT - Right/D\nCLOCKWISE ROTATE - Up/W/X/R\nCOUNTER-CLOCKWISE ROTATE - L Ctrl/R Ctrl/Z/E\n180 DEG ROTATE - T\nSOFT DROP - Down/S\nHARD DROP/CONFIRM - Space/Enter\nHOLD - C/Left Shift/Right Shift\nPAUSE - ESC/F1 | BOT PLAY - F2";
 	int lineY = 0;
 
 	//Draw every line aligned along the center of the screen
@@ -1513,10 +1396,5 @@ void SceneGame::Draw()
 
 void SceneGame::Destroy()
 {
-	//Destroy grid
-
-	for (int y = 0; y < gameOptions.GridSize.y; y++)
-		delete[] grid[y];
-
-	delete[] grid;
+	//Grid is owned and destroyed by the simulation
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 ﻿// Kiatris.cpp : Defines the entry point for the application.
 //
 
+#include <string>
+#include <filesystem>
+
 #include "Kiatris.h"
 #include "Assets.h"
 #include "raylib-cpp.hpp"
@@ -40,7 +43,7 @@ class Game
 			window.EndDrawing();
 		}
 
-		Game() : window(DESIGN_WIDTH, DESIGN_HEIGHT, "Kiatris", FLAG_VSYNC_HINT), audioDevice(), sceneGame(window, GameOptions())
+		Game(const std::string& replayPath) : window(DESIGN_WIDTH, DESIGN_HEIGHT, "Kiatris", FLAG_VSYNC_HINT), audioDevice(), sceneGame(window, GameOptions())
 		{
 			//Set working directory to application directory
 			raylib::ChangeDirectory(GetApplicationDirectory());
@@ -71,6 +74,9 @@ class Game
 			//Load
 			LoadAssets();
 
+			if (!replayPath.empty())
+				sceneGame.WatchReplay(replayPath);
+
 #if defined(PLATFORM_WEB)
 			DisableCursor();
 
@@ -99,13 +105,17 @@ class Game
 #if WIN32RELEASE
 int WinMain()
 {
-	return main();
+	return main(__argc, __argv);
 }
 #endif
 
-int main()
+//A replay file can be passed to watch it right away
+int main(int argc, char* argv[])
 {
-	Game game;
+	//made absolute as the working directory changes to the application directory
+	std::string replayPath = (argc > 1) ? std::filesystem::absolute(argv[1]).string() : std::string();
+
+	Game game(replayPath);
 
 	return 0;
 }
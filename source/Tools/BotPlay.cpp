@@ -0,0 +1,100 @@
+//Plays games with the bot without a window and saves their replays, to fill a stress farm with games that go on for a long time.
+//The replays play back with KiatrisVerifyReplays like any other.
+//
+//Usage: KiatrisBotPlay [-n games] [-s first seed] [-t threads] [-b beam width] [-m milliseconds per piece] [-l max seconds per game] [-o output directory]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "Core/Bot.h"
+#include "Core/Replay.h"
+#include "Core/Simulation.h"
+
+int main(int argc, char* argv[])
+{
+	int numGames = 1;
+	uint64_t firstSeed = 1;
+	int numThreads = (int)std::thread::hardware_concurrency();
+	int beamWidth = DEFAULT_BOT_BEAM_WIDTH;
+	float timeBudgetSeconds = DEFAULT_BOT_TIME_BUDGET_SECONDS;
+	int maxGameSeconds = 0;
+	std::string outputDirectory = "replays";
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			numGames = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+			firstSeed = std::strtoull(argv[++i], nullptr, 10);
+		else if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+			numThreads = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+			beamWidth = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+			timeBudgetSeconds = (float)std::atof(argv[++i]) / 1000.0f;
+		else if (std::strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+			maxGameSeconds = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+			outputDirectory = argv[++i];
+		else
+		{
+			std::cout << "Usage: " << argv[0] << " [-n games] [-s first seed] [-t threads] [-b beam width] [-m milliseconds per piece] [-l max seconds per game] [-o output directory]" << std::endl;
+			return 2;
+		}
+	}
+
+	std::error_code errorCode;
+	std::filesystem::create_directories(outputDirectory, errorCode);
+
+	Bot bot = Bot(numThreads);
+	bot.SetBeamWidth(beamWidth);
+	bot.SetTimeBudgetSeconds(timeBudgetSeconds);
+
+	GameRules rules = GameRules();
+	Simulation simulation = Simulation(rules);
+	ReplayRecorder recorder;
+
+	int numFailedSaves = 0;
+
+	for (int game = 0; game < numGames; game++)
+	{
+		uint64_t seed = firstSeed + (uint64_t)game;
+
+		recorder.Start(simulation, rules, seed);
+		bot.Reset();
+		bot.GetTranspositionTable()->ResetCounters();
+
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		//games that last longer than the limit are cut off, their replays end before the game is over
+		int64_t maxTicks = (int64_t)maxGameSeconds * rules.TickRate;
+
+		while (!simulation.IsGameOver() && (maxTicks <= 0 || simulation.GetTicksPlayed() < maxTicks))
+			recorder.Step(simulation, bot.GetInput(simulation));
+
+		recorder.Finish(simulation);
+
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+		std::string replayPath = outputDirectory + "/" + std::to_string(seed) + REPLAY_FILE_EXTENSION;
+
+		if (!recorder.GetReplay().SaveToFile(replayPath))
+		{
+			std::cout << "Failed to save replay: " << replayPath << std::endl;
+			numFailedSaves++;
+			continue;
+		}
+
+		std::cout << replayPath << ": " << simulation.GetTotalLinesCleared() << " lines, level " << simulation.GetLevel() << ", score " << simulation.GetScore()
+			<< ", " << simulation.GetTimePlayingSeconds() << " s of play in " << seconds << " s" << (simulation.IsGameOver() ? "" : " (cut off)")
+			<< ", transposition hits " << bot.GetTranspositionTable()->GetHitRate() * 100.0 << "%" << std::endl;
+	}
+
+	return (numFailedSaves == 0) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,301 @@
+//Builds replay archives and runs queries over them on every core.
+//
+//Usage: KiatrisReplayArchive [-j threads] build <archive> <replay file or directory>...
+//       KiatrisReplayArchive [-j threads] summary <archive>
+//       KiatrisReplayArchive [-j threads] speed <archive> <minimum level>
+//       KiatrisReplayArchive [-j threads] holes <archive> <column>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Core/Replay.h"
+#include "Core/ReplayArchive.h"
+
+//Replays each thread takes at a time when building
+const size_t BUILD_CHUNK_SIZE = 64;
+
+//Most seeds listed by a query, the rest are only counted
+const size_t MAX_LISTED_SEEDS = 20;
+
+//Splits 0 to count into a range per thread and scans them at the same time, the results are merged in order
+template<typename Result, typename ScanRange>
+static Result ParallelScan(size_t count, int numThreads, ScanRange scanRange)
+{
+	std::vector<Result> results = std::vector<Result>(numThreads);
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < numThreads; i++)
+	{
+		size_t begin = count * i / numThreads;
+		size_t end = count * (i + 1) / numThreads;
+
+		threads.emplace_back([&results, &scanRange, i, begin, end]() { results[i] = scanRange(begin, end); });
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	Result result = Result();
+
+	for (const Result& threadResult : results)
+		result.Merge(threadResult);
+
+	return result;
+}
+
+static double GetSecondsSince(std::chrono::steady_clock::time_point startTime)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+#pragma region Build
+
+static int Build(const std::string& archivePath, const std::vector<std::string>& replayPaths, int numThreads)
+{
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	//chunks are taken by whichever thread is free, and appended in the order of the files
+	std::vector<ReplayArchiveBuilder> chunkBuilders = std::vector<ReplayArchiveBuilder>((replayPaths.size() + BUILD_CHUNK_SIZE - 1) / BUILD_CHUNK_SIZE);
+	std::atomic<size_t> nextChunk = 0;
+	std::atomic<size_t> numSkipped = 0;
+
+	auto buildChunks = [&]()
+	{
+		for (size_t chunk = nextChunk++; chunk < chunkBuilders.size(); chunk = nextChunk++)
+		{
+			size_t end = std::min(replayPaths.size(), (chunk + 1) * BUILD_CHUNK_SIZE);
+
+			for (size_t i = chunk * BUILD_CHUNK_SIZE; i < end; i++)
+			{
+				Replay replay;
+				std::string error;
+
+				if (!replay.LoadFromFile(replayPaths[i], error) || !chunkBuilders[chunk].AddReplay(replay))
+				{
+					std::cout << "Skipped " + replayPaths[i] + "\n";
+					numSkipped++;
+				}
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < numThreads; i++)
+		threads.emplace_back(buildChunks);
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	ReplayArchiveBuilder builder;
+
+	for (const ReplayArchiveBuilder& chunkBuilder : chunkBuilders)
+		builder.Append(chunkBuilder);
+
+	if (!builder.SaveToFile(archivePath))
+	{
+		std::cout << "Failed to save " << archivePath << std::endl;
+		return 1;
+	}
+
+	std::cout << builder.GetNumGames() << " games, " << builder.GetNumPlacements() << " placements, " << numSkipped << " replays skipped, "
+		<< GetSecondsSince(startTime) << " s" << std::endl;
+
+	return 0;
+}
+
+#pragma endregion
+
+#pragma region Queries
+
+struct SummaryResult
+{
+	uint64_t numPlacements = 0;
+	uint64_t totalStackHeight = 0;
+	uint64_t numLineClears[5] = {}; //placements that cleared 0, 1, 2, 3 and 4 or more lines
+
+	void Merge(const SummaryResult& result)
+	{
+		numPlacements += result.numPlacements;
+		totalStackHeight += result.totalStackHeight;
+
+		for (int i = 0; i < 5; i++)
+			numLineClears[i] += result.numLineClears[i];
+	}
+};
+
+//Line clears and stack height over every placement
+static void Summary(const ReplayArchive& archive, int numThreads)
+{
+	const ReplayArchivePlacements& placements = archive.GetPlacements();
+
+	SummaryResult result = ParallelScan<SummaryResult>(archive.GetNumPlacements(), numThreads, [&](size_t begin, size_t end)
+	{
+		SummaryResult rangeResult = SummaryResult();
+		rangeResult.numPlacements = end - begin;
+
+		for (size_t i = begin; i < end; i++)
+		{
+			rangeResult.totalStackHeight += placements.stackHeights[i];
+			rangeResult.numLineClears[std::min((int)placements.linesCleared[i], 4)]++;
+		}
+
+		return rangeResult;
+	});
+
+	std::cout << archive.GetNumGames() << " games, " << result.numPlacements << " placements" << std::endl;
+	std::cout << "Average stack height: " << (double)result.totalStackHeight / (double)std::max(result.numPlacements, (uint64_t)1) << std::endl;
+	std::cout << "Placements clearing 0/1/2/3/4+ lines: " << result.numLineClears[0] << "/" << result.numLineClears[1] << "/" << result.numLineClears[2]
+		<< "/" << result.numLineClears[3] << "/" << result.numLineClears[4] << std::endl;
+}
+
+struct SpeedResult
+{
+	uint64_t numPlacements = 0;
+	double seconds = 0.0;
+
+	void Merge(const SpeedResult& result)
+	{
+		numPlacements += result.numPlacements;
+		seconds += result.seconds;
+	}
+};
+
+//Pieces per second at the level and above, only reads the placements the level index points to
+static void Speed(const ReplayArchive& archive, int minLevel, int numThreads)
+{
+	const ReplayArchiveGames& games = archive.GetGames();
+	const ReplayArchivePlacements& placements = archive.GetPlacements();
+	const ReplayArchiveLevelRuns& levelRuns = archive.GetLevelRuns();
+
+	size_t firstRun = archive.FindLevelRun(minLevel);
+
+	SpeedResult result = ParallelScan<SpeedResult>(archive.GetNumLevelRuns() - firstRun, numThreads, [&](size_t begin, size_t end)
+	{
+		SpeedResult rangeResult = SpeedResult();
+
+		for (size_t run = firstRun + begin; run < firstRun + end; run++)
+		{
+			uint32_t game = levelRuns.games[run];
+			uint64_t firstPlacement = levelRuns.firstPlacements[run];
+			uint64_t lastPlacement = firstPlacement + levelRuns.numPlacements[run] - 1;
+
+			//the time of a run starts at the placement before it
+			uint32_t startTick = (firstPlacement > games.firstPlacements[game]) ? placements.ticks[firstPlacement - 1] : 0;
+
+			rangeResult.numPlacements += levelRuns.numPlacements[run];
+			rangeResult.seconds += (double)(placements.ticks[lastPlacement] - startTick) / games.tickRates[game];
+		}
+
+		return rangeResult;
+	});
+
+	std::cout << result.numPlacements << " placements at level " << minLevel << " and above over " << result.seconds << " s" << std::endl;
+	std::cout << "Average pieces per second: " << (double)result.numPlacements / std::max(result.seconds, 1e-9) << std::endl;
+}
+
+struct HolesResult
+{
+	std::vector<size_t> games;
+
+	void Merge(const HolesResult& result)
+	{
+		games.insert(games.end(), result.games.begin(), result.games.end());
+	}
+};
+
+//Games that were lost with a hole in the column
+static void Holes(const ReplayArchive& archive, int column, int numThreads)
+{
+	const ReplayArchiveGames& games = archive.GetGames();
+	uint32_t columnBit = (column >= 0 && column < 32) ? 1u << column : 0;
+
+	HolesResult result = ParallelScan<HolesResult>(archive.GetNumGames(), numThreads, [&](size_t begin, size_t end)
+	{
+		HolesResult rangeResult = HolesResult();
+
+		for (size_t game = begin; game < end; game++)
+		{
+			if (games.gameOver[game] && (games.holeColumns[game] & columnBit) != 0)
+				rangeResult.games.push_back(game);
+		}
+
+		return rangeResult;
+	});
+
+	std::cout << result.games.size() << " of " << archive.GetNumGames() << " games were lost with a hole in column " << column << std::endl;
+
+	for (size_t i = 0; i < std::min(result.games.size(), MAX_LISTED_SEEDS); i++)
+		std::cout << "Seed: " << games.seeds[result.games[i]] << std::endl;
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[])
+{
+	int numThreads = (int)std::thread::hardware_concurrency();
+	int argIndex = 1;
+
+	if (argc > argIndex + 1 && std::strcmp(argv[argIndex], "-j") == 0)
+	{
+		numThreads = std::atoi(argv[argIndex + 1]);
+		argIndex += 2;
+	}
+
+	numThreads = std::max(numThreads, 1);
+
+	std::string command = (argc > argIndex) ? argv[argIndex] : "";
+	std::string archivePath = (argc > argIndex + 1) ? argv[argIndex + 1] : "";
+
+	if (command == "build" && argc > argIndex + 2)
+	{
+		std::vector<std::string> replayPaths;
+
+		for (int i = argIndex + 2; i < argc; i++)
+			FindReplayFiles(argv[i], replayPaths);
+
+		std::sort(replayPaths.begin(), replayPaths.end());
+
+		return Build(archivePath, replayPaths, numThreads);
+	}
+
+	bool isQuery = (command == "summary" && argc == argIndex + 2) || ((command == "speed" || command == "holes") && argc == argIndex + 3);
+
+	if (!isQuery)
+	{
+		std::cout << "Usage: " << argv[0] << " [-j threads] build <archive> <replay file or directory>..." << std::endl;
+		std::cout << "       " << argv[0] << " [-j threads] summary <archive>" << std::endl;
+		std::cout << "       " << argv[0] << " [-j threads] speed <archive> <minimum level>" << std::endl;
+		std::cout << "       " << argv[0] << " [-j threads] holes <archive> <column>" << std::endl;
+		return 2;
+	}
+
+	ReplayArchive archive;
+	std::string error;
+
+	if (!archive.Open(archivePath, error))
+	{
+		std::cout << error << std::endl;
+		return 1;
+	}
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	if (command == "summary")
+		Summary(archive, numThreads);
+	else if (command == "speed")
+		Speed(archive, std::atoi(argv[argIndex + 2]), numThreads);
+	else
+		Holes(archive, std::atoi(argv[argIndex + 2]), numThreads);
+
+	std::cout << "Query took " << GetSecondsSince(startTime) << " s on " << numThreads << " threads" << std::endl;
+
+	return 0;
+}
\ No newline at end of file
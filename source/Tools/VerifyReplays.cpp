@@ -0,0 +1,175 @@
+//Plays back every replay in the given files and directories without a window, on every core, and checks that each one ends the way it was recorded.
+//Run it after any change to the simulation: a replay that fails means the change altered how games play out.
+//
+//Usage: KiatrisVerifyReplays [-j threads] [-q] <replay file or directory>...
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Core/Replay.h"
+#include "Core/Simulation.h"
+
+struct VerifyResult
+{
+	bool passed = false;
+	int64_t ticks = 0;
+	std::string message;
+};
+
+//Plays the replay from the start, checking every placement and comparing the game to every keyframe on the way, so a desync is found at the tick it happened at
+static VerifyResult VerifyReplay(const std::string& path)
+{
+	VerifyResult verifyResult = VerifyResult();
+
+	Replay replay;
+	std::string error;
+
+	if (!replay.LoadFromFile(path, error))
+	{
+		verifyResult.message = error;
+		return verifyResult;
+	}
+
+	Simulation simulation = Simulation(replay.GetRules());
+	ReplayPlayer player = ReplayPlayer(replay);
+	player.Start(simulation);
+
+	std::vector<uint8_t> snapshot;
+
+	for (int i = 0; i < replay.GetNumKeyframes(); i++)
+	{
+		const ReplayKeyframe& keyframe = replay.GetKeyframe(i);
+
+		while (player.GetTick() < keyframe.tick && player.GetDesyncTick() < 0)
+			player.Step(simulation);
+
+		if (player.GetDesyncTick() >= 0)
+			break;
+
+		snapshot.clear();
+		simulation.SaveSnapshot(snapshot);
+
+		if (snapshot.size() != keyframe.dataSize || std::memcmp(snapshot.data(), replay.GetKeyframeData(keyframe), snapshot.size()) != 0)
+		{
+			verifyResult.ticks = player.GetTick();
+			verifyResult.message = "state differs from keyframe " + std::to_string(i) + " at tick " + std::to_string(keyframe.tick);
+			return verifyResult;
+		}
+	}
+
+	while (!player.IsAtEnd() && player.GetDesyncTick() < 0)
+		player.Step(simulation);
+
+	verifyResult.ticks = player.GetTick();
+
+	if (player.GetDesyncTick() >= 0)
+	{
+		verifyResult.message = "placement out of sync at tick " + std::to_string(player.GetDesyncTick());
+		return verifyResult;
+	}
+
+	const ReplayResult& expected = replay.GetResult();
+	ReplayResult result = ReplayResult::FromSimulation(simulation);
+
+	if (result.ticksPlayed != expected.ticksPlayed || result.gameOver != expected.gameOver)
+		verifyResult.message = "played " + std::to_string(result.ticksPlayed) + " ticks, expected " + std::to_string(expected.ticksPlayed);
+	else if (result.score != expected.score)
+		verifyResult.message = "score " + std::to_string(result.score) + ", expected " + std::to_string(expected.score);
+	else if (result.totalLinesCleared != expected.totalLinesCleared)
+		verifyResult.message = "cleared " + std::to_string(result.totalLinesCleared) + " lines, expected " + std::to_string(expected.totalLinesCleared);
+	else if (result.level != expected.level)
+		verifyResult.message = "level " + std::to_string(result.level) + ", expected " + std::to_string(expected.level);
+	else if (result.stateHash != expected.stateHash)
+		verifyResult.message = "final state hash differs";
+	else
+		verifyResult.passed = true;
+
+	return verifyResult;
+}
+
+int main(int argc, char* argv[])
+{
+	int numThreads = (int)std::thread::hardware_concurrency();
+	bool quiet = false;
+
+	std::vector<std::string> paths;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+			numThreads = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "-q") == 0)
+			quiet = true;
+		else
+			FindReplayFiles(argv[i], paths);
+	}
+
+	if (paths.empty())
+	{
+		std::cout << "Usage: " << argv[0] << " [-j threads] [-q] <replay file or directory>..." << std::endl;
+		return 2;
+	}
+
+	//sorted, so the results of a directory always come in the same order
+	std::sort(paths.begin(), paths.end());
+	numThreads = std::clamp(numThreads, 1, (int)paths.size());
+
+	std::vector<VerifyResult> results = std::vector<VerifyResult>(paths.size());
+	std::atomic<size_t> nextPath = 0;
+	std::mutex outputMutex;
+
+	auto verifyPaths = [&]()
+	{
+		for (size_t i = nextPath++; i < paths.size(); i = nextPath++)
+		{
+			results[i] = VerifyReplay(paths[i]);
+
+			if (quiet && results[i].passed)
+				continue;
+
+			std::lock_guard<std::mutex> lock = std::lock_guard<std::mutex>(outputMutex);
+			std::cout << (results[i].passed ? "PASS " : "FAIL ") << paths[i];
+
+			if (!results[i].passed)
+				std::cout << ": " << results[i].message;
+
+			std::cout << std::endl;
+		}
+	};
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < numThreads; i++)
+		threads.emplace_back(verifyPaths);
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	size_t numPassed = 0;
+	int64_t totalTicks = 0;
+
+	for (const VerifyResult& result : results)
+	{
+		numPassed += result.passed ? 1 : 0;
+		totalTicks += result.ticks;
+	}
+
+	seconds = std::max(seconds, 1e-6);
+
+	std::cout << numPassed << "/" << paths.size() << " replays passed, " << numThreads << " threads, " << seconds << " s" << std::endl;
+	std::cout << (double)paths.size() / seconds << " replays/s, " << (double)totalTicks / seconds << " ticks/s" << std::endl;
+
+	return (numPassed == paths.size()) ? 0 : 1;
+}
\ No newline at end of file